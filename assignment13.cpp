@@ -13,10 +13,28 @@
 #include <iostream>      // for CIN and COUT
 #include <fstream>       // for IFSTREAM
 #include <string>        // for STRING
+#include <vector>        // for VECTOR of the search queries
+#include <cstdlib>       // for RAND
+#include <algorithm>     // for MAX
 #include "graph.h"       // for Graph class which should be in graph.h
 #include "vertex.h"      // for Vertex, LVertex, and CVertex
 #include "maze.h"
+#include "course.h"
 #include "set.h"
+#include "bidirectional.h"
+#include "hybridsearch.h"
+#include "parallelsearch.h"
+#include "astar.h"
+#include "jumpsearch.h"
+#include "dijkstra.h"
+#include "multisource.h"
+#include "pathcache.h"
+#include "corridor.h"
+#include "deadend.h"
+#include "closure.h"
+#include "scc.h"
+#include "layers.h"
+#include "landmarks.h"
 //#include <set>
 using std::cout;
 using std::cin;
@@ -28,13 +46,13 @@ using std::ifstream;
 using namespace custom;
 //using namespace std;
 
-int Vertex::max = 10;
-
-// prototypes for our four test functions
+// prototypes for our six test functions
 void testSimple();
 void testAdd();
 void testQuery();
 void testFindAll();
+void testSearches();
+void testCourseOrder();
 
 // To get your program to compile, you might need to comment out a few
 // of these. The idea is to help you avoid too many compile errors at once.
@@ -44,6 +62,8 @@ void testFindAll();
 #define TEST2   // for testAdd()
 #define TEST3   // for testQuery()
 #define TEST4   // for testFindAll()
+#define TEST5   // for testSearches()
+#define TEST6   // for testCourseOrder()
 
 /**********************************************************************
  * MAIN
@@ -57,6 +77,8 @@ int main()
    cout << "\t2. The above plus add a few entries\n";
    cout << "\t3. Determine if two verticies are connected\n";
    cout << "\t4. Find all the verticies connected to a given vertex\n";
+   cout << "\t5. Compare the maze searches with breadth-first search\n";
+   cout << "\t6. Compare the course orderings with breadth-first search\n";
    cout << "\ta. Maze\n";
 
    // select
@@ -84,6 +106,14 @@ int main()
          testFindAll();
          cout << "Test 4 complete\n";
          break;
+      case '5':
+         testSearches();
+         cout << "Test 5 complete\n";
+         break;
+      case '6':
+         testCourseOrder();
+         cout << "Test 6 complete\n";
+         break;
       default:
          cout << "Unrecognized command, exiting...\n";
    }
@@ -186,8 +216,6 @@ void testAdd()
 #endif // TEST2   
 }
 
-int CVertex::maxCol = 0;
-
 /*******************************************
  * TEST Query
  * Determine if two verticies are connected
@@ -206,9 +234,9 @@ void testQuery()
       g2 = g1;
       g1.clear();
 
-      // need some variables
-      CVertex vFrom;
-      CVertex vTo;
+      // need some variables, sized to fit the maze
+      CVertex vFrom(g2.getContext());
+      CVertex vTo(g2.getContext());
    
       // allow the user to prompt for verticies  
       cout << "Determine if a given edge exists in the graph\n";
@@ -241,20 +269,9 @@ void testFindAll()
       CourseVertex vTo;
 
       {
-         Graph g2(g1.size());
-
          // read the class dependencies from a file
          // CS124 CS165 CIT225 ECEN160 |
-         ifstream fin("/home/cs235/week13/cs.txt");
-         assert(fin.good());
-         while (fin >> vFrom)  // read the first vertex, the class
-         {
-            while (fin >> vTo) // keep reading until the "|" is encountered
-               g2.add(vFrom, vTo);
-            fin.clear();       // clear the error state which came from the "|"
-            fin.ignore();
-         }
-         fin.close();
+         Graph g2(readCourses("/home/cs235/week13/cs.txt"));
          g1 = g2;
          g2.clear();
       }
@@ -281,3 +298,303 @@ void testFindAll()
 #endif // TEST4
 }
 
+
+/*******************************************
+ * IS PATH
+ * Does the path run from v1 to v2 along edges
+ * of g? An empty path passes; its length is
+ * checked on its own.
+ ******************************************/
+template <class G>
+bool isPath(const G & g, const Vector <Vertex> & path, int v1, int v2)
+{
+   if (path.size() == 0)
+      return true;
+   if (path[0].index() != v1 || path[path.size() - 1].index() != v2)
+      return false;
+   for (int i = 0; i + 1 < path.size(); i++)
+      if (!g.hasEdge(path[i].index(), path[i + 1].index()))
+         return false;
+   return true;
+}
+
+/*******************************************
+ * COMPARE SEARCH
+ * Run one search over every query and count the
+ * answers that are not a path of the length
+ * breadth-first search found
+ ******************************************/
+template <class G, class Search>
+void compareSearch(const char * name, const G & g,
+                   const std::vector <int> & from,
+                   const std::vector <int> & to,
+                   const std::vector <int> & lengths, Search search)
+{
+   Vector <Vertex> path;
+   int numWrong = 0;
+   for (size_t i = 0; i < from.size(); i++)
+   {
+      Vertex v1(from[i], g.getContext());
+      Vertex v2(to[i], g.getContext());
+      bool found = search(v1, v2, path);
+      if (found != (lengths[i] != 0) || path.size() != lengths[i] ||
+          !isPath(g, path, from[i], to[i]))
+         numWrong++;
+   }
+   cout << '\t' << name << ": " << numWrong << " of " << from.size()
+        << " differ\n";
+}
+
+/*******************************************
+ * TEST SEARCHES
+ * Read a maze and ask every search the same
+ * random questions breadth-first search has
+ * already answered
+ ******************************************/
+void testSearches()
+{
+#ifdef TEST5
+   try
+   {
+      cout << "What is the filename? ";
+      string fileName;
+      cin >> fileName;
+      GridGraph g = readMaze <GridGraph> (fileName.c_str());
+      const VertexContext & context = g.getContext();
+
+      // the questions and the breadth-first answers
+      const int NUM_QUERIES = 1000;
+      std::vector <int> from;
+      std::vector <int> to;
+      std::vector <int> lengths;
+      SearchWorkspace ws(g.size());
+      SearchWorkspace backward(g.size());
+      Vector <Vertex> path;
+      srand(13);
+      for (int i = 0; i < NUM_QUERIES; i++)
+      {
+         from.push_back(rand() % g.size());
+         to.push_back(rand() % g.size());
+         g.findPath(Vertex(from.back(), context), Vertex(to.back(), context),
+                    ws, path);
+         lengths.push_back(path.size());
+      }
+      cout << "Compare " << NUM_QUERIES << " searches in a maze of "
+           << g.size() << " cells\n";
+
+      compareSearch("bidirectional", g, from, to, lengths,
+         [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+         {
+            return findPathBidirectional(g, v1, v2, ws, backward, path);
+         });
+
+      // a bit matrix of a big maze would not fit
+      if (g.size() <= 20000)
+      {
+         DenseGraph dense(g.size(), g.numColumns());
+         for (int v = 0; v < g.size(); v++)
+            g.forEachEdge(v, [&](int n) { dense.addEdge(v, n); });
+         HybridSearch hybrid(dense);
+         compareSearch("hybrid", g, from, to, lengths,
+            [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+            {
+               return hybrid.findPath(v1, v2, path);
+            });
+      }
+
+      ThreadPool pool;
+      ParallelWorkspace parallel;
+      compareSearch("parallel", g, from, to, lengths,
+         [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+         {
+            return findPathParallel(g, v1, v2, pool, parallel, path);
+         });
+
+      compareSearch("A*", g, from, to, lengths,
+         [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+         {
+            return findPathAStar(g, v1, v2, ws, path);
+         });
+
+      compareSearch("jump point", g, from, to, lengths,
+         [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+         {
+            return findPathJumpPoint(g, v1, v2, ws, path);
+         });
+
+      // every edge costing one, the cheapest path is also the shortest
+      CsrGraph weighted(g.size(), g.numColumns());
+      for (int v = 0; v < g.size(); v++)
+         g.forEachEdge(v, [&](int n) { weighted.addEdge(v, n, 1); });
+      compareSearch("Dijkstra", g, from, to, lengths,
+         [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+         {
+            bool found = findCheapestPath(weighted, v1, v2, ws, path);
+            if (found && ws.distance(v2.index()) != path.size() - 1)
+               path.clear();
+            return found;
+         });
+
+      // all the sources against all the targets in one go
+      const int NUM_SOURCES = 16;
+      Vector <Vertex> sources;
+      Vector <Vertex> targets;
+      for (int i = 0; i < NUM_SOURCES; i++)
+      {
+         sources.push_back(Vertex(from[i], context));
+         targets.push_back(Vertex(to[i], context));
+      }
+      DistanceMatrix distances;
+      findDistances(g, sources, targets, distances);
+      int numWrong = 0;
+      for (int i = 0; i < NUM_SOURCES; i++)
+         for (int j = 0; j < NUM_SOURCES; j++)
+         {
+            g.findPath(sources[i], targets[j], ws, path);
+            if (distances(i, j) != path.size() - 1)
+               numWrong++;
+         }
+      cout << "\tmultisource: " << numWrong << " of "
+           << NUM_SOURCES * NUM_SOURCES << " differ\n";
+
+      // the first time through every path is solved, the second time
+      // every one comes out of the cache
+      PathCache cache(64 << 20);
+      auto cached = [&](const Vertex & v1, const Vertex & v2,
+                        Vector <Vertex> & path)
+      {
+         return findPathCached(g, v1, v2, cache, ws, path);
+      };
+      compareSearch("cache, solving", g, from, to, lengths, cached);
+      compareSearch("cache, remembered", g, from, to, lengths, cached);
+      cout << "\t\t" << cache.numHits() << " hits, " << cache.numMisses()
+           << " misses\n";
+
+      CorridorGraph corridors(g);
+      compareSearch("corridor", g, from, to, lengths,
+         [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+         {
+            return corridors.findPath(v1, v2, ws, path);
+         });
+
+      // filling keeps every path between two open cells, and a filled
+      // cell is walled off, so no path leads to or from it
+      DeadEndView <GridGraph> view(g, Vertex(0, context),
+                                   Vertex(g.size() - 1, context));
+      std::vector <int> lengthsOpen(lengths);
+      for (size_t i = 0; i < from.size(); i++)
+         if (view.isFilled(from[i]) || view.isFilled(to[i]))
+            lengthsOpen[i] = 0;
+      compareSearch("dead end", g, from, to, lengthsOpen,
+         [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+         {
+            return view.findPath(v1, v2, ws, path);
+         });
+
+      // the index must agree with the search on what can be reached
+      g.trackComponents();
+      compareSearch("components", g, from, to, lengths,
+         [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+         {
+            bool reachable = g.isReachable(v1, v2);
+            if (g.findPath(v1, v2, ws, path) != reachable)
+               path.clear();
+            return reachable;
+         });
+      g.stopTracking();
+
+      Landmarks landmarks(g, 8, pool);
+      compareSearch("ALT", g, from, to, lengths,
+         [&](const Vertex & v1, const Vertex & v2, Vector <Vertex> & path)
+         {
+            return findPathLandmarks(g, v1, v2, landmarks, ws, path);
+         });
+   }
+   catch (const char * error)
+   {
+      cout << error << endl;
+   }
+#endif // TEST5
+}
+
+/*******************************************
+ * TEST COURSE ORDER
+ * Read the course prerequisites and check what
+ * is worked out from them against breadth-first
+ * search between every pair of classes
+ ******************************************/
+void testCourseOrder()
+{
+#ifdef TEST6
+   try
+   {
+      cout << "What is the filename? ";
+      string fileName;
+      cin >> fileName;
+      Graph g = readCourses(fileName.c_str());
+      const VertexContext & context = g.getContext();
+      int numV = g.size();
+
+      // reaches[u][v]: a path of one or more edges runs from u to v
+      SearchWorkspace ws(numV);
+      Vector <Vertex> path;
+      std::vector <std::vector <char> > reaches(numV,
+                                                std::vector <char> (numV, 0));
+      for (int u = 0; u < numV; u++)
+         g.forEachEdge(u, [&](int n)
+         {
+            for (int v = 0; v < numV; v++)
+               if (g.findPath(Vertex(n, context), Vertex(v, context), ws, path))
+                  reaches[u][v] = 1;
+         });
+
+      TransitiveClosure closure(g);
+      int numWrong = 0;
+      for (int u = 0; u < numV; u++)
+         for (int v = 0; v < numV; v++)
+            if (closure.reaches(u, v) != (reaches[u][v] != 0))
+               numWrong++;
+      cout << "\tclosure: " << numWrong << " of " << numV * numV
+           << " differ\n";
+
+      // together in a component when each reaches the other
+      StrongComponents components(g);
+      numWrong = 0;
+      for (int u = 0; u < numV; u++)
+      {
+         if (components.isCyclic(u) != (reaches[u][u] != 0))
+            numWrong++;
+         for (int v = 0; v < numV; v++)
+            if ((components.component(u) == components.component(v)) !=
+                (u == v || (reaches[u][v] && reaches[v][u])))
+               numWrong++;
+      }
+      cout << "\tstrong components: " << numWrong << " wrong\n";
+
+      // a class waiting on no cycle comes a semester after the last
+      // of its prerequisites; one that is waiting has no semester
+      ThreadPool pool;
+      TopologicalLayers layers(g, pool);
+      numWrong = 0;
+      for (int u = 0; u < numV; u++)
+      {
+         bool waiting = false;
+         for (int v = 0; v < numV; v++)
+            if (reaches[v][v] && (u == v || reaches[u][v]))
+               waiting = true;
+         int layer = 0;
+         g.forEachEdge(u, [&](int n)
+         {
+            layer = std::max(layer, layers.layerOf(n) + 1);
+         });
+         if (layers.layerOf(u) != (waiting ? -1 : layer))
+            numWrong++;
+      }
+      cout << "\tlayers: " << numWrong << " of " << numV << " differ\n";
+   }
+   catch (const char * error)
+   {
+      cout << error << endl;
+   }
+#endif // TEST6
+}
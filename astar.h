@@ -0,0 +1,145 @@
+/***********************************************************************
+ * Header:
+ *    A STAR
+ * Summary:
+ *    Informed point-to-point search. A* expands vertices in order of
+ *    their distance from v1 plus an estimate of the distance left to
+ *    v2, so with a good estimate it heads for the goal instead of
+ *    flooding outward. The estimate is a plug-in: any object with
+ *        int operator () (int v) const
+ *    that never overestimates the hops from v to the goal gives the
+ *    same path length as BasicGraph::findPath. Like findPath it counts
+ *    hops; for edges with costs see findCheapestPath() in dijkstra.h.
+ *        ManhattanHeuristic : rows plus columns to the goal on a grid
+ *        ZeroHeuristic      : no estimate; the search is a plain BFS
+ *        findPathAStar()    : a shortest path from v1 to v2
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef ASTAR_H
+#define ASTAR_H
+
+#include <cstdlib>
+#include "graph.h"
+#include "search.h"
+
+/*****************************************
+ * MANHATTAN HEURISTIC
+ * Every step on a maze grid changes the row or the
+ * column by one, so the row and column differences
+ * to the goal are a lower bound on the steps left.
+ * On a graph without columns it estimates zero.
+ ****************************************/
+class ManhattanHeuristic
+{
+public:
+	ManhattanHeuristic(const VertexContext& context, int goal)
+		: numCol(context.maxCol), goalRow(0), goalCol(0)
+	{
+		if (numCol > 0)
+		{
+			goalRow = goal / numCol;
+			goalCol = goal % numCol;
+		}
+	}
+	int operator()(int v) const
+	{
+		if (numCol <= 0)
+			return 0;
+		return abs(v / numCol - goalRow) + abs(v % numCol - goalCol);
+	}
+
+private:
+	int numCol;
+	int goalRow;
+	int goalCol;
+};
+
+/*****************************************
+ * ZERO HEURISTIC
+ * No information at all
+ ****************************************/
+struct ZeroHeuristic
+{
+	int operator()(int v) const { return 0; }
+};
+
+/*********************************************
+ * FIND PATH A STAR
+ * A shortest path from v1 to v2 guided by the
+ * heuristic. Ties in the estimated total go to
+ * the vertex furthest along, which keeps the
+ * search from fanning out across open areas.
+ * Vertices are pushed again when a shorter way
+ * to them turns up, and the stale entries are
+ * skipped when they surface. Returns false, with
+ * an empty path, when v2 cannot be reached.
+ ********************************************/
+template <class G, class Heuristic>
+bool findPathAStar(const G& g, const Vertex& v1, const Vertex& v2,
+                   const Heuristic& estimate, SearchWorkspace& ws,
+                   Vector<Vertex>& path) throw (const char*)
+{
+	g.pack();
+	ws.begin(g.size());
+	path.clear();
+
+	// smaller total first, then the larger distance travelled
+	auto keyOf = [](int distance, int total)
+	{
+		return ((long long)total << 32) - distance;
+	};
+
+	int start = v1.index();
+	int goal = v2.index();
+	DaryHeap<4>& open = ws.heap();
+	ws.visit(start, start, 0);
+	open.push(keyOf(0, estimate(start)), start);
+	bool found = false;
+	while (!open.empty())
+	{
+		HeapItem item = open.top();
+		open.pop();
+		int v = item.value;
+		int d = ws.distance(v);
+		if (item.key != keyOf(d, d + estimate(v)))
+			continue;   // a shorter way here was found after this push
+		if (v == goal)
+		{
+			found = true;
+			break;
+		}
+		ws.expand();
+		g.forEachEdge(v, [&](int n)
+		{
+			if (!ws.isVisited(n) || d + 1 < ws.distance(n))
+			{
+				ws.visit(n, v, d + 1);
+				open.push(keyOf(d + 1, d + 1 + estimate(n)), n);
+			}
+		});
+	}
+	if (!found)
+		return false;
+
+	ws.buildPath(start, goal, g.getContext(), path);
+	return true;
+}
+
+/*********************************************
+ * FIND PATH A STAR (Manhattan)
+ * On a maze grid the default estimate is the
+ * Manhattan distance taken from the graph's
+ * own columns
+ ********************************************/
+template <class G>
+bool findPathAStar(const G& g, const Vertex& v1, const Vertex& v2,
+                   SearchWorkspace& ws, Vector<Vertex>& path) throw (const char*)
+{
+	return findPathAStar(g, v1, v2,
+	                     ManhattanHeuristic(g.getContext(), v2.index()),
+	                     ws, path);
+}
+
+#endif // ASTAR_H
@@ -0,0 +1,103 @@
+/***********************************************************************
+ * Header:
+ *    BITS
+ * Summary:
+ *    Helpers for working with rows of bits packed into machine words:
+ *        Word               : the unit of storage, 64 bits
+ *        numWords()         : how many words it takes to hold n bits
+ *        countTrailingZeros : index of the lowest set bit in a word
+ *        countLeadingZeros  : how many bits sit above the highest set bit
+ *        popCount           : number of set bits in a word
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef BITS_H
+#define BITS_H
+
+#include <cstddef>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+typedef unsigned long long Word;
+const int WORD_BITS = 64;
+
+/**********************************************
+ * NUM WORDS
+ * The number of words needed to hold numBits bits
+ **********************************************/
+inline int numWords(int numBits)
+{
+   return (numBits + WORD_BITS - 1) / WORD_BITS;
+}
+
+/**********************************************
+ * BIT MASK
+ * The word with only bit (index % 64) set
+ **********************************************/
+inline Word bitMask(int index)
+{
+   return (Word)1 << (index % WORD_BITS);
+}
+
+/**********************************************
+ * COUNT TRAILING ZEROS
+ * The position of the lowest set bit. The word
+ * must not be zero.
+ **********************************************/
+inline int countTrailingZeros(Word w)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+   unsigned long index;
+   _BitScanForward64(&index, w);
+   return (int)index;
+#elif defined(_MSC_VER)
+   unsigned long index;
+   if (_BitScanForward(&index, (unsigned long)w))
+      return (int)index;
+   _BitScanForward(&index, (unsigned long)(w >> 32));
+   return (int)index + 32;
+#else
+   return __builtin_ctzll(w);
+#endif
+}
+
+/**********************************************
+ * COUNT LEADING ZEROS
+ * The number of zero bits above the highest set
+ * bit. The word must not be zero.
+ **********************************************/
+inline int countLeadingZeros(Word w)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+   unsigned long index;
+   _BitScanReverse64(&index, w);
+   return 63 - (int)index;
+#elif defined(_MSC_VER)
+   unsigned long index;
+   if (_BitScanReverse(&index, (unsigned long)(w >> 32)))
+      return 31 - (int)index;
+   _BitScanReverse(&index, (unsigned long)w);
+   return 63 - (int)index;
+#else
+   return __builtin_clzll(w);
+#endif
+}
+
+/**********************************************
+ * POP COUNT
+ * The number of set bits in a word
+ **********************************************/
+inline int popCount(Word w)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+   return (int)__popcnt64(w);
+#elif defined(_MSC_VER)
+   return (int)(__popcnt((unsigned int)w) + __popcnt((unsigned int)(w >> 32)));
+#else
+   return __builtin_popcountll(w);
+#endif
+}
+
+#endif // BITS_H
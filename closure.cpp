@@ -0,0 +1,76 @@
+#include <new>
+#include "closure.h"
+
+/*********************************************
+ * TRANSITIVE CLOSURE :: ALLOCATE
+ * An empty matrix for numVertices vertices
+ ********************************************/
+void TransitiveClosure::allocate(int numVertices) throw (const char*)
+{
+	numV = numVertices;
+	rowWords = numWords(numVertices);
+	size_t size = (size_t)numV * rowWords;
+	try
+	{
+		matrix = new Word[size];
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the transitive closure.";
+	}
+	for (size_t i = 0; i < size; ++i)
+		matrix[i] = 0;
+}
+
+/*********************************************
+ * OR ROW
+ * dest |= source, a word at a time
+ ********************************************/
+static inline void orRow(Word* dest, const Word* source, int numWords)
+{
+	for (int w = 0; w < numWords; ++w)
+		dest[w] |= source[w];
+}
+
+/*********************************************
+ * TRANSITIVE CLOSURE :: CLOSE
+ * Warshall's algorithm. Once k has been the
+ * middle vertex, a row holds every vertex it
+ * reaches through vertices 0 .. k, so any row
+ * reaching k takes on all of row k. A row that
+ * reaches nothing has nothing to pass on.
+ ********************************************/
+void TransitiveClosure::close()
+{
+	for (int k = 0; k < numV; k++)
+	{
+		const Word* through = row(k);
+		bool empty = true;
+		for (int w = 0; w < rowWords && empty; ++w)
+			empty = (through[w] == 0);
+		if (empty)
+			continue;
+
+		int word = k / WORD_BITS;
+		Word mask = bitMask(k);
+		for (int u = 0; u < numV; u++)
+		{
+			Word* r = row(u);
+			if ((r[word] & mask) && u != k)
+				orRow(r, through, rowWords);
+		}
+	}
+}
+
+/*********************************************
+ * TRANSITIVE CLOSURE :: COUNT
+ * The number of bits set in the row of u
+ ********************************************/
+int TransitiveClosure::count(int u) const
+{
+	const Word* r = row(u);
+	int total = 0;
+	for (int w = 0; w < rowWords; ++w)
+		total += popCount(r[w]);
+	return total;
+}
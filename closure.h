@@ -0,0 +1,87 @@
+/***********************************************************************
+ * Header:
+ *    CLOSURE
+ * Summary:
+ *    The transitive closure of a graph: for every pair of vertices,
+ *    whether any path leads from one to the other. It is worked out
+ *    once with Warshall's algorithm over rows of bits, so bringing in
+ *    everything reachable through a vertex is an OR of one row into
+ *    another, 64 vertices to a word, and a query afterwards is a single
+ *    bit test. For the course graph, the row of a class holds every
+ *    class it requires, however far back.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef CLOSURE_H
+#define CLOSURE_H
+
+#include <cstddef>
+#include "bits.h"
+#include "vertex.h"
+
+/*****************************************
+ * TRANSITIVE CLOSURE
+ * numVertices rows of numVertices bits, so it
+ * suits graphs of up to some tens of thousands
+ * of vertices. It copies what it needs and sees
+ * no edges added to the graph afterwards.
+ ****************************************/
+class TransitiveClosure
+{
+public:
+	template <class G>
+	TransitiveClosure(const G& g) throw (const char*);
+	~TransitiveClosure() { delete[] matrix; }
+
+	int size() const { return numV; }
+
+	// a path of one or more edges runs from u to v
+	bool reaches(int u, int v) const
+	{
+		return (row(u)[v / WORD_BITS] & bitMask(v)) != 0;
+	}
+	bool reaches(const Vertex& u, const Vertex& v) const
+	{
+		return reaches(u.index(), v.index());
+	}
+
+	// everything u reaches, as numRowWords() words of bits
+	const Word* row(int u) const { return matrix + (size_t)u * rowWords; }
+	int numRowWords() const { return rowWords; }
+
+	// how many vertices u reaches
+	int count(int u) const;
+
+private:
+	TransitiveClosure(const TransitiveClosure& rhs);
+	TransitiveClosure& operator=(const TransitiveClosure& rhs);
+
+	void allocate(int numVertices) throw (const char*);
+	void close();
+	Word* row(int u) { return matrix + (size_t)u * rowWords; }
+
+	Word* matrix;
+	int numV;
+	int rowWords;
+};
+
+/*********************************************
+ * TRANSITIVE CLOSURE : CONSTRUCTOR
+ * Start from the edges of g and close them
+ ********************************************/
+template <class G>
+TransitiveClosure::TransitiveClosure(const G& g) throw (const char*)
+	: matrix(NULL), numV(0), rowWords(0)
+{
+	allocate(g.size());
+	g.pack();
+	for (int u = 0; u < numV; u++)
+	{
+		Word* r = row(u);
+		g.forEachEdge(u, [&](int v) { r[v / WORD_BITS] |= bitMask(v); });
+	}
+	close();
+}
+
+#endif // CLOSURE_H
@@ -0,0 +1,60 @@
+#include <new>
+#include "components.h"
+
+/*********************************************
+ * COMPONENTS :: INIT
+ * Start over with every vertex its own root
+ ********************************************/
+void Components::init(int numVertices) throw (const char*)
+{
+	try
+	{
+		parents.resize(numVertices);
+		ranks.assign(numVertices, 0);
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the components.";
+	}
+	for (int v = 0; v < numVertices; v++)
+		parents[v] = v;
+	count = numVertices;
+}
+
+/*********************************************
+ * COMPONENTS :: COMPRESS
+ * Find the root of v, pointing every other
+ * vertex on the way at its grandparent. Halving
+ * the path like this needs only the one pass.
+ ********************************************/
+int Components::compress(int v)
+{
+	while (parents[v] != v)
+	{
+		parents[v] = parents[parents[v]];
+		v = parents[v];
+	}
+	return v;
+}
+
+/*********************************************
+ * COMPONENTS :: UNITE
+ * Hang the shallower tree under the deeper one
+ ********************************************/
+void Components::unite(int v1, int v2)
+{
+	int r1 = compress(v1);
+	int r2 = compress(v2);
+	if (r1 == r2)
+		return;
+	if (ranks[r1] < ranks[r2])
+		parents[r1] = r2;
+	else if (ranks[r2] < ranks[r1])
+		parents[r2] = r1;
+	else
+	{
+		parents[r2] = r1;
+		ranks[r1]++;
+	}
+	count--;
+}
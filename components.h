@@ -0,0 +1,73 @@
+/***********************************************************************
+ * Header:
+ *    COMPONENTS
+ * Summary:
+ *    The connected components of a graph, kept up to date one edge at
+ *    a time with union-find: union by rank keeps every tree shallow,
+ *    and the finds done while joining compress the paths they walk.
+ *    Two vertices in different components have no path between them,
+ *    in either direction, so a search between them can be turned down
+ *    without looking at a single edge.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <vector>
+
+/*****************************************
+ * COMPONENTS
+ * Edges are taken as undirected. Queries only
+ * read, leaving the compressing to unite, so
+ * threads may ask at the same time; union by
+ * rank alone keeps a find to O(log n) steps.
+ ****************************************/
+class Components
+{
+public:
+	Components() : count(0) {}
+
+	// every one of numVertices vertices on its own
+	void init(int numVertices) throw (const char*);
+
+	// the components of every edge of g, both ways
+	template <class G>
+	void build(const G& g) throw (const char*)
+	{
+		init(g.size());
+		for (int v = 0; v < g.size(); v++)
+			g.forEachEdge(v, [&](int n) { unite(v, n); });
+	}
+
+	// forget everything, freeing the memory
+	void release()
+	{
+		std::vector<int>().swap(parents);
+		std::vector<unsigned char>().swap(ranks);
+		count = 0;
+	}
+	bool isBuilt() const { return !parents.empty(); }
+
+	// join the components of v1 and v2
+	void unite(int v1, int v2);
+
+	int find(int v) const
+	{
+		while (parents[v] != v)
+			v = parents[v];
+		return v;
+	}
+	bool isConnected(int v1, int v2) const { return find(v1) == find(v2); }
+	int numComponents() const { return count; }
+
+private:
+	int compress(int v);
+
+	std::vector<int> parents;
+	std::vector<unsigned char> ranks;
+	int count;
+};
+
+#endif // COMPONENTS_H
@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include "corridor.h"
+
+/*********************************************
+ * CORRIDOR GRAPH :: BUILD
+ * Make the edges undirected, pick out the
+ * junctions, walk every corridor between them,
+ * and join the junctions with one edge per
+ * corridor
+ ********************************************/
+void CorridorGraph::build(std::vector<int>& pairs) throw (const char*)
+{
+	int numV = (int)junctionOf.size();
+
+	// every edge both ways, sorted into rows without repeats or loops
+	std::vector<long long> edges;
+	for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+		if (pairs[i] != pairs[i + 1])
+		{
+			edges.push_back(((long long)pairs[i] << 32) | pairs[i + 1]);
+			edges.push_back(((long long)pairs[i + 1] << 32) | pairs[i]);
+		}
+	std::vector<int>().swap(pairs);
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+	offsets.assign(numV + 1, 0);
+	neighbors.resize(edges.size());
+	for (size_t i = 0; i < edges.size(); i++)
+	{
+		offsets[(edges[i] >> 32) + 1]++;
+		neighbors[i] = (int)(edges[i] & 0xFFFFFFFF);
+	}
+	for (int v = 0; v < numV; v++)
+		offsets[v + 1] += offsets[v];
+
+	// a cell with two ways out is part of a corridor
+	corridorOf.assign(numV, -1);
+	positionOf.assign(numV, 0);
+	for (int v = 0; v < numV; v++)
+		if (offsets[v + 1] - offsets[v] == 2)
+			junctionOf[v] = -1;
+		else
+		{
+			junctionOf[v] = (int)junctions.size();
+			junctions.push_back(v);
+		}
+	for (int j = 0; j < (int)junctions.size(); j++)
+		walkCorridors(j);
+
+	// a loop with no junction on it gets one
+	for (int v = 0; v < numV; v++)
+		if (junctionOf[v] == -1 && corridorOf[v] == -1)
+		{
+			junctionOf[v] = (int)junctions.size();
+			junctions.push_back(v);
+			walkCorridors(junctionOf[v]);
+		}
+
+	// the junction graph, leaving out corridors that come back to their start
+	int numJ = (int)junctions.size();
+	edgeOffsets.assign(numJ + 1, 0);
+	for (int c = 0; c < numCorridors(); c++)
+		if (corridorFrom[c] != corridorTo[c])
+		{
+			edgeOffsets[corridorFrom[c] + 1]++;
+			edgeOffsets[corridorTo[c] + 1]++;
+		}
+	for (int j = 0; j < numJ; j++)
+		edgeOffsets[j + 1] += edgeOffsets[j];
+	edgeTargets.resize(edgeOffsets[numJ]);
+	edgeCorridors.resize(edgeOffsets[numJ]);
+	std::vector<int> fill(edgeOffsets.begin(), edgeOffsets.end() - 1);
+	for (int c = 0; c < numCorridors(); c++)
+		if (corridorFrom[c] != corridorTo[c])
+		{
+			edgeTargets[fill[corridorFrom[c]]] = corridorTo[c];
+			edgeCorridors[fill[corridorFrom[c]]++] = c;
+			edgeTargets[fill[corridorTo[c]]] = corridorFrom[c];
+			edgeCorridors[fill[corridorTo[c]]++] = c;
+		}
+}
+
+/*********************************************
+ * CORRIDOR GRAPH :: WALK CORRIDORS
+ * Follow every way out of a junction that has
+ * not been walked yet to the junction at its
+ * other end, numbering the cells along the way.
+ * A direct edge between two junctions is a
+ * corridor with no cells, taken from the lower
+ * numbered end only.
+ ********************************************/
+void CorridorGraph::walkCorridors(int junction)
+{
+	int from = junctions[junction];
+	for (int i = offsets[from]; i < offsets[from + 1]; i++)
+	{
+		int cell = neighbors[i];
+		if (junctionOf[cell] != -1 ? junctionOf[cell] < junction
+		                           : corridorOf[cell] != -1)
+			continue;
+
+		int c = numCorridors();
+		corridorFrom.push_back(junction);
+		corridorStart.push_back((int)cells.size());
+		int prev = from;
+		int pos = 1;
+		while (junctionOf[cell] == -1)
+		{
+			corridorOf[cell] = c;
+			positionOf[cell] = pos++;
+			cells.push_back(cell);
+			int next = neighbors[offsets[cell]];
+			if (next == prev)
+				next = neighbors[offsets[cell] + 1];
+			prev = cell;
+			cell = next;
+		}
+		corridorTo.push_back(junctionOf[cell]);
+		corridorLength.push_back(pos);
+	}
+}
+
+/*********************************************
+ * CORRIDOR GRAPH :: CELL AT
+ * The cell pos steps along a corridor: pos 0 is
+ * the junction it starts at, pos length the one
+ * it ends at
+ ********************************************/
+int CorridorGraph::cellAt(int corridor, int pos) const
+{
+	if (pos == 0)
+		return junctions[corridorFrom[corridor]];
+	if (pos == corridorLength[corridor])
+		return junctions[corridorTo[corridor]];
+	return cells[corridorStart[corridor] + pos - 1];
+}
+
+/*********************************************
+ * CORRIDOR GRAPH :: APPEND CELLS
+ * Add the cells of a corridor from pos from up
+ * to, but not including, pos to
+ ********************************************/
+void CorridorGraph::appendCells(int corridor, int from, int to,
+                                Vector<Vertex>& path) const
+{
+	int delta = from < to ? 1 : -1;
+	for (int pos = from; pos != to; pos += delta)
+		path.push_back(Vertex(cellAt(corridor, pos), context));
+}
+
+/*********************************************
+ * CORRIDOR GRAPH :: FIND PATH
+ * Dijkstra over the junctions. A cell midway
+ * along a corridor starts the search from both
+ * ends of it, as far away as the steps to each,
+ * and a goal midway along one is reached from
+ * either end. The search stops once nothing left
+ * on the heap can beat the best way found, which
+ * may also be a straight run along the corridor
+ * both cells share. The parent of each junction
+ * is the corridor it was reached by, -1 at the
+ * start.
+ ********************************************/
+bool CorridorGraph::findPath(const Vertex& v1, const Vertex& v2,
+                             SearchWorkspace& ws, Vector<Vertex>& path) const
+	throw (const char*)
+{
+	ws.begin(numJunctions());
+	path.clear();
+	int start = v1.index();
+	int goal = v2.index();
+	RadixHeap& open = ws.radixHeap();
+	auto reach = [&](int junction, int parent, int distance)
+	{
+		if (!ws.isVisited(junction) || distance < ws.distance(junction))
+		{
+			ws.visit(junction, parent, distance);
+			open.push(distance, junction);
+		}
+	};
+
+	// the ways out of the start
+	int sc = corridorOf[start];
+	int sp = positionOf[start];
+	if (sc == -1)
+		reach(junctionOf[start], -1, 0);
+	else
+	{
+		reach(corridorFrom[sc], -1, sp);
+		reach(corridorTo[sc], -1, corridorLength[sc] - sp);
+	}
+
+	// a run straight along the corridor the two cells share
+	int gc = corridorOf[goal];
+	int gp = positionOf[goal];
+	int best = INT_MAX;
+	int bestJunction = -1;
+	if (start == goal)
+		best = 0;
+	else if (sc != -1 && sc == gc)
+		best = std::abs(gp - sp);
+
+	while (!open.empty() && open.top().key < best)
+	{
+		HeapItem item = open.top();
+		open.pop();
+		int j = item.value;
+		int d = ws.distance(j);
+		if (item.key != d)
+			continue;
+		ws.expand();
+
+		// is this a way to the goal?
+		int left = INT_MAX;
+		if (gc == -1)
+		{
+			if (junctions[j] == goal)
+				left = 0;
+		}
+		else
+		{
+			if (corridorFrom[gc] == j)
+				left = gp;
+			if (corridorTo[gc] == j)
+				left = std::min(left, corridorLength[gc] - gp);
+		}
+		if (left != INT_MAX && d + left < best)
+		{
+			best = d + left;
+			bestJunction = j;
+		}
+
+		for (int e = edgeOffsets[j]; e < edgeOffsets[j + 1]; e++)
+			reach(edgeTargets[e], edgeCorridors[e],
+			      d + corridorLength[edgeCorridors[e]]);
+	}
+	if (best == INT_MAX)
+		return false;
+
+	// built from the goal back, then reversed
+	if (bestJunction == -1)
+	{
+		if (start == goal)
+			path.push_back(Vertex(goal, context));
+		else
+			appendCells(gc, gp, sp + (sp < gp ? -1 : 1), path);
+	}
+	else
+	{
+		// the goal's corridor, out to the junction
+		int j = bestJunction;
+		if (gc != -1)
+		{
+			bool fromEnd = (corridorFrom[gc] == j &&
+			                ws.distance(j) + gp == best);
+			appendCells(gc, gp, fromEnd ? 0 : corridorLength[gc], path);
+		}
+
+		// junction to junction along the corridors that reached them
+		for (int c = ws.predecessor(j); c != -1; c = ws.predecessor(j))
+		{
+			if (corridorTo[c] == j)
+			{
+				appendCells(c, corridorLength[c], 0, path);
+				j = corridorFrom[c];
+			}
+			else
+			{
+				appendCells(c, 0, corridorLength[c], path);
+				j = corridorTo[c];
+			}
+		}
+
+		// the junction the search started at, in to the start
+		path.push_back(Vertex(junctions[j], context));
+		if (sc != -1)
+		{
+			if (corridorFrom[sc] == j && ws.distance(j) == sp)
+				appendCells(sc, 1, sp + 1, path);
+			else
+				appendCells(sc, corridorLength[sc] - 1, sp - 1, path);
+		}
+	}
+	for (int i = 0, k = path.size() - 1; i < k; ++i, --k)
+	{
+		Vertex tmp = path[i];
+		path[i] = path[k];
+		path[k] = tmp;
+	}
+	return true;
+}
@@ -0,0 +1,98 @@
+/***********************************************************************
+ * Header:
+ *    CORRIDOR
+ * Summary:
+ *    A maze with its corridors squeezed out. Most cells of a maze have
+ *    exactly two open walls and are just a step along a corridor, so
+ *    the searching can be done on the junctions and dead ends alone,
+ *    joined by one edge per corridor that costs its length. A query
+ *    starts and ends on the corridors holding its cells, runs Dijkstra
+ *    over the junctions, and the corridors along the way are unrolled
+ *    again into the full path of cells that drawMaze expects.
+ *
+ *    Maze tunnels go both ways, so the edges of the graph are taken as
+ *    undirected, the same way drawMaze reads them.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef CORRIDOR_H
+#define CORRIDOR_H
+
+#include <vector>
+#include "graph.h"
+#include "search.h"
+
+/*****************************************
+ * CORRIDOR GRAPH
+ * Built once from a finished maze; it keeps no
+ * link to the graph, so it does not see edges
+ * added afterwards. Queries only read it, so
+ * threads with their own workspaces may share it.
+ ****************************************/
+class CorridorGraph
+{
+public:
+	template <class G>
+	CorridorGraph(const G& g) throw (const char*);
+
+	int numVertices() const { return (int)junctionOf.size(); }
+	int numJunctions() const { return (int)junctions.size(); }
+	int numCorridors() const { return (int)corridorFrom.size(); }
+
+	// a shortest path from v1 to v2, the same length as findPath finds
+	bool findPath(const Vertex& v1, const Vertex& v2, SearchWorkspace& ws,
+	              Vector<Vertex>& path) const throw (const char*);
+
+private:
+	void build(std::vector<int>& pairs) throw (const char*);
+	void walkCorridors(int junction);
+	int cellAt(int corridor, int pos) const;
+	void appendCells(int corridor, int from, int to, Vector<Vertex>& path) const;
+
+	VertexContext context;
+
+	// the maze with every edge both ways, in compressed rows
+	std::vector<int> offsets;
+	std::vector<int> neighbors;
+
+	// junctions: every cell that is not midway along a corridor
+	std::vector<int> junctions;     // junction --> cell
+	std::vector<int> junctionOf;    // cell --> junction, or -1
+
+	// corridors: the cells strictly between two junctions, in order
+	std::vector<int> corridorFrom;  // corridor --> the junction at pos 0
+	std::vector<int> corridorTo;    // corridor --> the junction at pos length
+	std::vector<int> corridorStart; // corridor --> where its cells begin
+	std::vector<int> corridorLength;// corridor --> steps from end to end
+	std::vector<int> cells;         // the cells of every corridor
+	std::vector<int> corridorOf;    // cell --> corridor, or -1 at a junction
+	std::vector<int> positionOf;    // cell --> its pos along the corridor
+
+	// the junction graph: one edge each way per corridor
+	std::vector<int> edgeOffsets;
+	std::vector<int> edgeTargets;
+	std::vector<int> edgeCorridors;
+};
+
+/*********************************************
+ * CORRIDOR GRAPH : CONSTRUCTOR
+ * Collect the edges of g, both ways, and build
+ ********************************************/
+template <class G>
+CorridorGraph::CorridorGraph(const G& g) throw (const char*)
+	: context(g.getContext())
+{
+	g.pack();
+	std::vector<int> pairs;
+	for (int v = 0; v < g.size(); v++)
+		g.forEachEdge(v, [&](int n)
+		{
+			pairs.push_back(v);
+			pairs.push_back(n);
+		});
+	junctionOf.resize(g.size());
+	build(pairs);
+}
+
+#endif // CORRIDOR_H
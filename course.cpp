@@ -0,0 +1,59 @@
+/***********************************************************************
+ * Component:
+ *    Assignment 13, Courses
+ *    Brother Helfrich, CS 235
+ * Author:
+ *    Scott Tolman
+ * Summary:
+ *    Read the course prerequisite graph
+ ************************************************************************/
+
+#include <iostream>
+#include "course.h"
+#include "vertex.h"
+#include "scanner.h"
+
+using std::cout;
+using std::endl;
+
+/*********************************************
+ * READ COURSES
+ * Every class gets an edge to each of its
+ * prerequisites. A prerequisite list runs until
+ * the first token that is not a class name,
+ * normally the "|", so a line missing its "|"
+ * carries on into the next line.
+ ********************************************/
+template <class G>
+G readCourses(const char* fileName)
+{
+   G g(NUM_CLASS);
+
+   Scanner fin;
+   if (!fin.open(fileName))
+   {
+      cout << "ERROR: Unable to open file " << fileName << endl;
+      return g;
+   }
+
+   const char* token;
+   int length;
+   int course;
+   int prerequisite;
+   while (fin.next(token, length) &&
+          (course = CourseVertex::indexFromText(token, length)) != -1)
+   {
+      while (fin.next(token, length) &&
+             (prerequisite = CourseVertex::indexFromText(token, length)) != -1)
+         g.addEdge(course, prerequisite);
+   }
+
+   fin.close();
+   g.pack();
+   return g;
+}
+
+// the graphs the courses can be read into
+template DenseGraph readCourses <DenseGraph> (const char* fileName);
+template CsrGraph   readCourses <CsrGraph>   (const char* fileName);
+template ListGraph  readCourses <ListGraph>  (const char* fileName);
@@ -0,0 +1,22 @@
+/***********************************************************************
+ * Component:
+ *    Assignment 13, Courses
+ *    Brother Helfrich, CS 235
+ * Author:
+ *    Scott Tolman
+ * Summary:
+ *    Read the course prerequisite graph
+ ************************************************************************/
+
+#ifndef COURSE_H
+#define COURSE_H
+
+#include "graph.h"
+
+// read the class dependencies from a file such as cs.txt, where each
+// class is followed by its prerequisites and a "|":
+//    CS306 CS235 CS237 |
+template <class G = Graph>
+G readCourses(const char* fileName);
+
+#endif // COURSE_H
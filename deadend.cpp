@@ -0,0 +1,61 @@
+#include "deadend.h"
+
+/*********************************************
+ * FILL DEAD ENDS
+ * Gather the neighbors of every cell both ways
+ * in compressed rows, drop repeats and loops
+ * with a stamp per cell so it stays linear,
+ * then fill cells with at most one neighbor
+ * left until the worklist runs dry
+ ********************************************/
+void fillDeadEnds(int numV, const std::vector<int>& pairs, int start,
+                  int goal, std::vector<char>& filled)
+{
+	std::vector<int> offsets(numV + 1, 0);
+	for (size_t i = 0; i < pairs.size(); i++)
+		offsets[pairs[i] + 1]++;
+	for (int v = 0; v < numV; v++)
+		offsets[v + 1] += offsets[v];
+	std::vector<int> neighbors(pairs.size());
+	std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+	for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+	{
+		neighbors[fill[pairs[i]]++] = pairs[i + 1];
+		neighbors[fill[pairs[i + 1]]++] = pairs[i];
+	}
+
+	// fill now holds the end of each row; keep the distinct neighbors
+	std::vector<int> degree(numV, 0);
+	std::vector<int> seen(numV, -1);
+	for (int v = 0; v < numV; v++)
+	{
+		seen[v] = v;
+		int end = offsets[v];
+		for (int i = offsets[v]; i < fill[v]; i++)
+			if (seen[neighbors[i]] != v)
+			{
+				seen[neighbors[i]] = v;
+				neighbors[end++] = neighbors[i];
+			}
+		fill[v] = end;
+		degree[v] = end - offsets[v];
+	}
+
+	filled.assign(numV, 0);
+	std::vector<int> worklist;
+	for (int v = 0; v < numV; v++)
+		if (degree[v] <= 1 && v != start && v != goal)
+			worklist.push_back(v);
+	while (!worklist.empty())
+	{
+		int v = worklist.back();
+		worklist.pop_back();
+		filled[v] = 1;
+		for (int i = offsets[v]; i < fill[v]; i++)
+		{
+			int n = neighbors[i];
+			if (!filled[n] && --degree[n] == 1 && n != start && n != goal)
+				worklist.push_back(n);
+		}
+	}
+}
@@ -0,0 +1,132 @@
+/***********************************************************************
+ * Header:
+ *    DEAD END
+ * Summary:
+ *    Dead-end filling. A cell with only one way in is a dead end and no
+ *    path between two other cells passes through it, so it is filled
+ *    in; that can leave its neighbor a dead end in turn. Filling from
+ *    a worklist until none are left takes time linear in the maze and
+ *    leaves a perfect maze with nothing but the corridor from the start
+ *    to the goal. Loops, and whatever hangs between them, stay open.
+ *
+ *    The tunnels are taken as going both ways, the same way drawMaze
+ *    reads them, when counting the ways out of a cell.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef DEADEND_H
+#define DEADEND_H
+
+#include <vector>
+#include "graph.h"
+#include "search.h"
+
+// fill the dead ends of a graph with numV vertices and the given
+// (from, to) pairs, never filling start or goal
+void fillDeadEnds(int numV, const std::vector<int>& pairs, int start,
+                  int goal, std::vector<char>& filled);
+
+/*****************************************
+ * DEAD END VIEW
+ * A graph with its dead ends filled in. It reads
+ * through to the graph it was made from, which
+ * must outlive it and not change underneath it,
+ * and answers the same queries as the graph with
+ * the filled cells walled off, so findPath and
+ * drawMaze take it in place of the graph.
+ ****************************************/
+template <class G>
+class DeadEndView
+{
+public:
+	DeadEndView(const G& g, const Vertex& start, const Vertex& goal)
+		throw (const char*);
+
+	int size() const { return graph.size(); }
+	const VertexContext& getContext() const { return graph.getContext(); }
+	void pack() const { graph.pack(); }
+	bool isFilled(int v) const { return filled[v] != 0; }
+	int numFilled() const { return count; }
+
+	bool hasEdge(int v1, int v2) const
+	{
+		return !filled[v1] && !filled[v2] && graph.hasEdge(v1, v2);
+	}
+	bool isEdge(const Vertex& v1, const Vertex& v2) const
+	{
+		return hasEdge(v1.index(), v2.index());
+	}
+	template <class F>
+	void forEachEdge(int v, F f) const
+	{
+		if (!filled[v])
+			graph.forEachEdge(v, [&](int n)
+			{
+				if (!filled[n])
+					f(n);
+			});
+	}
+
+	Vector <Vertex> findPath(const Vertex& v1, const Vertex& v2) const;
+	bool findPath(const Vertex& v1, const Vertex& v2,
+	              SearchWorkspace& ws, Vector<Vertex>& path) const;
+
+private:
+	const G& graph;
+	std::vector<char> filled;
+	int count;
+};
+
+/*********************************************
+ * DEAD END VIEW : CONSTRUCTOR
+ * Collect the edges of g and fill its dead ends,
+ * keeping start and goal open
+ ********************************************/
+template <class G>
+DeadEndView<G>::DeadEndView(const G& g, const Vertex& start,
+                            const Vertex& goal) throw (const char*)
+	: graph(g), count(0)
+{
+	g.pack();
+	std::vector<int> pairs;
+	for (int v = 0; v < g.size(); v++)
+		g.forEachEdge(v, [&](int n)
+		{
+			pairs.push_back(v);
+			pairs.push_back(n);
+		});
+	fillDeadEnds(g.size(), pairs, start.index(), goal.index(), filled);
+	for (int v = 0; v < g.size(); v++)
+		count += filled[v];
+}
+
+/*********************************************
+ * DEAD END VIEW :: FIND PATH
+ * Breadth-first search that never enters a
+ * filled cell. Filling keeps every path between
+ * open cells, so the path is as short as the
+ * one the graph itself finds.
+ ********************************************/
+template <class G>
+Vector<Vertex> DeadEndView<G>::findPath(const Vertex& v1, const Vertex& v2) const
+{
+	SearchWorkspace ws(size());
+	Vector<Vertex> path;
+	findPath(v1, v2, ws, path);
+	return path;
+}
+
+template <class G>
+bool DeadEndView<G>::findPath(const Vertex& v1, const Vertex& v2,
+                              SearchWorkspace& ws, Vector<Vertex>& path) const
+{
+	if (filled[v1.index()] || filled[v2.index()])
+	{
+		path.clear();
+		return false;
+	}
+	return findPathBreadthFirst(*this, v1, v2, ws, path);
+}
+
+#endif // DEADEND_H
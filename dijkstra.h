@@ -0,0 +1,76 @@
+/***********************************************************************
+ * Header:
+ *    DIJKSTRA
+ * Summary:
+ *    Cheapest paths over edges with costs. Dijkstra's algorithm takes
+ *    vertices off a RadixHeap in order of their cost from v1; since
+ *    the costs are small integers that never make a path cheaper, the
+ *    keys only grow and every pop is O(1) amortized. A graph with no
+ *    costs is left to the breadth-first search, which finds the same
+ *    answer faster.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef DIJKSTRA_H
+#define DIJKSTRA_H
+
+#include "graph.h"
+#include "search.h"
+
+/*********************************************
+ * FIND CHEAPEST PATH
+ * The path from v1 to v2 with the smallest total
+ * cost; afterward ws.distance(v2.index()) holds
+ * that cost. Returns false, with an empty path,
+ * when v2 cannot be reached.
+ ********************************************/
+template <class G>
+bool findCheapestPath(const G& g, const Vertex& v1, const Vertex& v2,
+                      SearchWorkspace& ws, Vector<Vertex>& path)
+	throw (const char*)
+{
+	if (!g.isWeighted())
+		return g.findPath(v1, v2, ws, path);
+
+	g.pack();
+	ws.begin(g.size());
+	path.clear();
+
+	int start = v1.index();
+	int goal = v2.index();
+	RadixHeap& open = ws.radixHeap();
+	ws.visit(start, start, 0);
+	open.push(0, start);
+	bool found = false;
+	while (!open.empty())
+	{
+		HeapItem item = open.top();
+		open.pop();
+		int v = item.value;
+		int d = ws.distance(v);
+		if (item.key != d)
+			continue;   // a cheaper way here was found after this push
+		if (v == goal)
+		{
+			found = true;
+			break;
+		}
+		ws.expand();
+		g.forEachWeightedEdge(v, [&](int n, Weight w)
+		{
+			if (!ws.isVisited(n) || d + w < ws.distance(n))
+			{
+				ws.visit(n, v, d + w);
+				open.push(d + w, n);
+			}
+		});
+	}
+	if (!found)
+		return false;
+
+	ws.buildPath(start, goal, g.getContext(), path);
+	return true;
+}
+
+#endif // DIJKSTRA_H
@@ -1,31 +1,268 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <new>
+#include <atomic>
+#include "storage.h"
 #include "set.h"
 #include "list.h"
 #include "vertex.h"
 #include "vector.h"
 #include "queue.h"
+#include "search.h"
+#include "components.h"
 
+/*****************************************
+ * NEXT GRAPH ID
+ * A number never handed out before, shared by
+ * graphs of every storage policy. Taken once per
+ * graph, never per edge.
+ ****************************************/
+inline unsigned long long nextGraphId()
+{
+	static std::atomic<unsigned long long> counter(0);
+	return ++counter;
+}
 
-class Graph
+/*****************************************
+ * BASIC GRAPH
+ * A graph of Vertex objects over one of the storage
+ * policies in storage.h. The policy is chosen at
+ * compile time so the hot isEdge path has no
+ * virtual dispatch. The graph owns the context its
+ * vertices are read and printed with; for a maze
+ * grid that includes the number of columns.
+ *
+ * Every graph, copies included, has an id no
+ * other graph shares, and counts the changes made
+ * to its edges. The two together name one state
+ * of one graph, so a result remembered along with
+ * them can tell when it is stale.
+ *
+ * On request the graph also keeps its connected
+ * components as edges are added, so a search
+ * between two vertices with nothing joining them
+ * is turned down at once. The index costs about
+ * five bytes a vertex, ten times what a grid
+ * spends on its walls, so it is off until
+ * trackComponents() is called.
+ ****************************************/
+template <class Storage>
+class BasicGraph : public Storage
 {
 public:
-	Graph(int numNodes) throw (const char*);
-	Graph(const Graph& rhs);
-	~Graph();
-	Graph& operator=(const Graph& rhs) throw (const char*);
-	int size() const { return numV; }
-	void clear();
-	bool isEdge(const Vertex& v1, const Vertex& v2) const;
-	set <Vertex> findEdges(const Vertex& v);
-	void add(Vertex v1, Vertex v2);
+	BasicGraph(int numNodes, int numCol = 0) throw (const char*)
+		: context(numNodes, numCol), id(nextGraphId()), edits(0)
+	{
+		this->init(numNodes, numCol);
+	}
+	BasicGraph(const char* fileName) throw (const char*)
+		: id(nextGraphId()), edits(0)
+	{
+		this->open(fileName);
+		context = VertexContext(this->numVertices(), this->numColumns());
+	}
+	BasicGraph(const BasicGraph& rhs) throw (const char*)
+		: Storage(rhs), context(rhs.context), components(rhs.components),
+		  id(nextGraphId()), edits(0)
+	{
+	}
+	BasicGraph& operator=(const BasicGraph& rhs) throw (const char*)
+	{
+		Storage::operator=(rhs);
+		context = rhs.context;
+		components = rhs.components;
+		id = nextGraphId();
+		edits = 0;
+		return *this;
+	}
+	int size() const { return this->numVertices(); }
+	const VertexContext& getContext() const { return context; }
+	bool isEdge(const Vertex& v1, const Vertex& v2) const
+	{
+		return this->hasEdge(v1.index(), v2.index());
+	}
+	set <Vertex> findEdges(const Vertex& v) const;
+	void add(Vertex v1, Vertex v2) { this->addEdge(v1.index(), v2.index()); }
+	void add(Vertex v1, Vertex v2, Weight w)
+	{
+		this->addEdge(v1.index(), v2.index(), w);
+	}
 	void add(Vertex v1, set<Vertex> s);
-	Vector <Vertex> findPath(const Vertex& v1, const Vertex& v2);
+	Vector <Vertex> findPath(const Vertex& v1, const Vertex& v2) const;
+	bool findPath(const Vertex& v1, const Vertex& v2,
+	              SearchWorkspace& ws, Vector<Vertex>& path) const;
+
+	// keep the connected components from now on, starting with the
+	// edges already there; stopTracking() frees them again. Until then
+	// numComponents() is 0.
+	void trackComponents() throw (const char*) { components.build(*this); }
+	void stopTracking() { components.release(); }
+	bool isTracking() const { return components.isBuilt(); }
+	int numComponents() const { return components.numComponents(); }
+
+	// false when nothing joins the two, whichever way the edges point;
+	// exact when every edge goes both ways, as in a maze. Without the
+	// components it is answered by findPath, along the edges.
+	bool isReachable(const Vertex& v1, const Vertex& v2) const
+	{
+		if (isTracking())
+			return components.isConnected(v1.index(), v2.index());
+		SearchWorkspace ws(size());
+		Vector<Vertex> path;
+		return findPath(v1, v2, ws, path);
+	}
+
+	// the storage changes, each one counted
+	void addEdge(int v1, int v2)
+	{
+		edits++;
+		Storage::addEdge(v1, v2);
+		if (isTracking())
+			components.unite(v1, v2);
+	}
+	void addEdge(int v1, int v2, Weight w)
+	{
+		edits++;
+		Storage::addEdge(v1, v2, w);
+		if (isTracking())
+			components.unite(v1, v2);
+	}
+	void clear()
+	{
+		edits++;
+		Storage::clear();
+		if (isTracking())
+			components.init(size());
+	}
+	void assign(const std::vector<int>* lists, int numLists, ThreadPool& pool)
+	{
+		edits++;
+		Storage::assign(lists, numLists, pool);
+		if (isTracking())
+			components.build(*this);
+	}
+
+	// only read, so searches on several threads may ask at once. The
+	// searches themselves may too, but only on a packed graph; see
+	// CsrStorage.
+	unsigned long long getId() const { return id; }
+	unsigned long long getEdits() const { return edits; }
+
 private:
-	bool* matrix;
-	int numV;
-	int lines;
+	VertexContext context;
+	Components components;
+	unsigned long long id;      // this graph's alone, even among copies
+	unsigned long long edits;   // changes since it was made
 };
 
+typedef BasicGraph<DenseStorage> DenseGraph;
+typedef BasicGraph<CsrStorage>   CsrGraph;
+typedef BasicGraph<ListStorage>  ListGraph;
+typedef BasicGraph<GridStorage>  GridGraph;
+
+// the storage behind plain Graph, e.g. -DGRAPH_STORAGE=CsrStorage or
+// ListStorage. GridStorage cannot be the default: a course graph has
+// no columns, so readCourses is not made for GridGraph. Nor can
+// MappedStorage, which is read-only and only ever opened from a file.
+#ifndef GRAPH_STORAGE
+#define GRAPH_STORAGE DenseStorage
+#endif
+typedef BasicGraph<GRAPH_STORAGE> Graph;
+
+template <class Storage>
+set<Vertex> BasicGraph<Storage>::findEdges(const Vertex& v) const
+{
+	set<Vertex> s;
+	this->forEachEdge(v.index(), [&](int n) { s.insert(Vertex(n, context)); });
+	return s;
+}
+
+template <class Storage>
+void BasicGraph<Storage>::add(Vertex v1, set<Vertex> s)
+{
+	for (set<Vertex>::iterator it = s.begin(); it != s.end(); ++it)
+		this->addEdge(v1.index(), (*it).index());
+}
+
+/*********************************************
+ * FIND PATH BREADTH FIRST
+ * Breadth-first search from v1 over any graph
+ * with size(), getContext() and forEachEdge(),
+ * using the caller's scratch space and path.
+ * Fills in the vertices from v1 through v2, or
+ * returns false with an empty path.
+ ********************************************/
+template <class G>
+bool findPathBreadthFirst(const G& g, const Vertex& v1, const Vertex& v2,
+                          SearchWorkspace& ws, Vector<Vertex>& path)
+{
+	g.pack();
+	ws.begin(g.size());
+	path.clear();
+
+	int* toVisit = ws.frontier();
+	int head = 0;
+	int tail = 0;
+	int goal = v2.index();
+	toVisit[tail++] = v1.index();
+	ws.visit(v1.index(), v1.index(), 0);
+	while (head < tail && !ws.isVisited(goal))
+	{
+		int v = toVisit[head++];
+		int d = ws.distance(v) + 1;
+		ws.expand();
+		g.forEachEdge(v, [&](int n)
+		{
+			if (!ws.isVisited(n))
+			{
+				ws.visit(n, v, d);
+				toVisit[tail++] = n;
+			}
+		});
+	}
+	if (!ws.isVisited(goal))
+		return false;
+
+	ws.buildPath(v1.index(), goal, g.getContext(), path);
+	return true;
+}
+
+/*********************************************
+ * BASIC GRAPH :: FIND PATH
+ * Breadth-first search from v1. Returns the
+ * vertices from v1 through v2, or an empty path
+ * when v2 cannot be reached. When the graph
+ * tracks its components, vertices in different
+ * ones are turned down without a search.
+ ********************************************/
+template <class Storage>
+Vector<Vertex> BasicGraph<Storage>::findPath(const Vertex& v1, const Vertex& v2) const
+{
+	SearchWorkspace ws(size());
+	Vector<Vertex> path;
+	findPath(v1, v2, ws, path);
+	return path;
+}
+
+/*********************************************
+ * BASIC GRAPH :: FIND PATH (reusing a workspace)
+ * The same search using the caller's scratch
+ * space, filling in the caller's path. Once the
+ * workspace and path have grown to fit, a query
+ * allocates nothing. Returns false, with an empty
+ * path, when v2 cannot be reached.
+ ********************************************/
+template <class Storage>
+bool BasicGraph<Storage>::findPath(const Vertex& v1, const Vertex& v2,
+                                   SearchWorkspace& ws, Vector<Vertex>& path) const
+{
+	if (isTracking() && !components.isConnected(v1.index(), v2.index()))
+	{
+		path.clear();
+		return false;
+	}
+	return findPathBreadthFirst(*this, v1, v2, ws, path);
+}
+
 #endif // !GRAPH_H
@@ -0,0 +1,82 @@
+#include <cstring>
+#include <climits>
+#include "graphfile.h"
+
+/*********************************************
+ * MAPPED STORAGE :: OPEN
+ * Map a graph file and point the offsets and
+ * neighbors arrays into it. The header, the file
+ * length and the first and last offsets are
+ * checked; nothing else is read. The file is
+ * mapped and checked on the side, so when it is
+ * turned down the storage still reads the file
+ * it had before.
+ ********************************************/
+void MappedStorage::open(const char* fileName) throw (const char*)
+{
+	MappedFile mapped;
+	mapped.open(fileName);
+
+	const GraphFileHeader* header = (const GraphFileHeader*)mapped.data();
+	if (mapped.size() < sizeof(GraphFileHeader) ||
+	    memcmp(header->magic, GRAPH_FILE_MAGIC, 4) != 0)
+		throw "ERROR: Not a graph file.";
+	if (header->version != GRAPH_FILE_VERSION)
+		throw "ERROR: Unsupported graph file version.";
+	size_t expected = sizeof(GraphFileHeader) +
+		((size_t)header->numVertices + 1 + header->numEdges) * sizeof(int);
+	if (mapped.size() != expected)
+		throw "ERROR: The graph file is truncated.";
+
+	// the ends of the rows; the rows themselves are trusted, see validate()
+	const int* rows = (const int*)(mapped.data() + sizeof(GraphFileHeader));
+	if (header->numVertices >= INT_MAX || header->numEdges > INT_MAX ||
+	    header->numColumns > INT_MAX || rows[0] != 0 ||
+	    rows[header->numVertices] != (int)header->numEdges)
+		throw "ERROR: The graph file is corrupt.";
+
+	// all good: the old mapping goes when mapped does
+	std::string name(fileName);
+	file.swap(mapped);
+	this->fileName.swap(name);
+	numV = header->numVertices;
+	numCol = header->numColumns;
+	offsets = rows;
+	neighbors = offsets + numV + 1;
+}
+
+/*********************************************
+ * MAPPED STORAGE :: VALIDATE
+ * Check every row: offsets never go down and
+ * every neighbor is a vertex. This reads the
+ * whole file, so open() leaves it to callers
+ * whose files may be damaged.
+ ********************************************/
+void MappedStorage::validate() const throw (const char*)
+{
+	for (int v = 0; v < numV; ++v)
+	{
+		if (offsets[v + 1] < offsets[v])
+			throw "ERROR: The graph file is corrupt.";
+		for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+			if (neighbors[i] < 0 || neighbors[i] >= numV)
+				throw "ERROR: The graph file is corrupt.";
+	}
+}
+
+MappedStorage& MappedStorage::operator=(const MappedStorage & rhs) throw (const char*)
+{
+	if (&rhs == this)
+		return *this;
+	if (rhs.file.isOpen())
+		open(rhs.fileName.c_str());
+	else
+	{
+		file.close();
+		numV = 0;
+		numCol = 0;
+		offsets = NULL;
+		neighbors = NULL;
+	}
+	return *this;
+}
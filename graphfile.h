@@ -0,0 +1,176 @@
+/***********************************************************************
+ * Header:
+ *    GRAPH FILE
+ * Summary:
+ *    A binary on-disk form of a graph, laid out exactly like CsrStorage
+ *    so it can be used straight from a memory mapping without any
+ *    parsing or copying:
+ *        GraphFileHeader  : magic, version, and the counts
+ *        int offsets  [numVertices + 1]
+ *        int neighbors[numEdges], each row sorted
+ *    All values are in the byte order of the machine that wrote them.
+ *
+ *        writeGraph()  : save any graph in this format
+ *        MappedStorage : a read-only storage policy over a mapped file
+ *        MappedGraph   : the Graph built on it
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef GRAPHFILE_H
+#define GRAPHFILE_H
+
+#include <fstream>
+#include <string>
+#include <algorithm>
+#include "graph.h"
+#include "mapfile.h"
+
+#define GRAPH_FILE_MAGIC   "CSRG"
+#define GRAPH_FILE_VERSION 1
+
+/*****************************************
+ * GRAPH FILE HEADER
+ * The first 24 bytes of a graph file
+ ****************************************/
+struct GraphFileHeader
+{
+	char magic[4];            // GRAPH_FILE_MAGIC, no terminator
+	unsigned int version;     // GRAPH_FILE_VERSION
+	unsigned int numVertices;
+	unsigned int numColumns;  // the width of a maze grid, 0 if not a grid
+	unsigned int numEdges;
+	unsigned int reserved;    // zero; keeps the arrays 8-byte aligned
+};
+
+/*****************************************
+ * MAPPED STORAGE
+ * Serves hasEdge and forEachEdge straight out of
+ * a mapped graph file. Read-only: addEdge and
+ * clear throw. Copying maps the same file again.
+ * Opening checks the header, the size and where
+ * the rows start and end, but trusts the rows in
+ * between so no more of the file is read than
+ * the queries touch. Call validate() on a file
+ * that may be damaged.
+ ****************************************/
+class MappedStorage
+{
+public:
+	MappedStorage() : numV(0), numCol(0), offsets(NULL), neighbors(NULL) {}
+	MappedStorage(const MappedStorage& rhs) throw (const char*)
+		: numV(0), numCol(0), offsets(NULL), neighbors(NULL) { *this = rhs; }
+	MappedStorage& operator=(const MappedStorage& rhs) throw (const char*);
+
+	void open(const char* fileName) throw (const char*);
+	void validate() const throw (const char*);
+	int numVertices() const { return numV; }
+	int numColumns() const { return numCol; }
+	int numEdges() const { return numV ? offsets[numV] : 0; }
+	void pack() const {}
+
+	void clear() throw (const char*)
+	{
+		throw "ERROR: A mapped graph is read-only.";
+	}
+	void addEdge(int v1, int v2) throw (const char*)
+	{
+		throw "ERROR: A mapped graph is read-only.";
+	}
+
+	bool hasEdge(int v1, int v2) const
+	{
+		return std::binary_search(neighbors + offsets[v1],
+		                          neighbors + offsets[v1 + 1], v2);
+	}
+
+	template <class Visit>
+	void forEachEdge(int v, Visit visit) const
+	{
+		for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+			visit(neighbors[i]);
+	}
+
+	// the file format has no costs, so every edge costs 1
+	bool isWeighted() const { return false; }
+	void addEdge(int v1, int v2, Weight w) throw (const char*)
+	{
+		throw "ERROR: A mapped graph is read-only.";
+	}
+	Weight weight(int v1, int v2) const { return 1; }
+	template <class Visit>
+	void forEachWeightedEdge(int v, Visit visit) const
+	{
+		for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+			visit(neighbors[i], (Weight)1);
+	}
+
+private:
+	MappedFile file;
+	std::string fileName;
+	int numV;
+	int numCol;
+	const int* offsets;
+	const int* neighbors;
+};
+
+typedef BasicGraph<MappedStorage> MappedGraph;
+
+/*********************************************
+ * WRITE GRAPH
+ * Save a graph in the binary format. numCol is
+ * the width of the maze grid, or 0 if the graph
+ * is not a grid.
+ ********************************************/
+template <class G>
+void writeGraph(const G& g, const char* fileName, int numCol = 0) throw (const char*)
+{
+	g.pack();
+	int numV = g.size();
+
+	// first pass: the offsets, from the degree of every vertex
+	Vector<int> offsets(numV + 1);
+	offsets.push_back(0);
+	int maxDegree = 0;
+	for (int v = 0; v < numV; ++v)
+	{
+		int degree = 0;
+		g.forEachEdge(v, [&degree](int n) { degree++; });
+		offsets.push_back(offsets[v] + degree);
+		maxDegree = std::max(maxDegree, degree);
+	}
+
+	std::ofstream fout(fileName, std::ios::binary);
+	if (fout.fail())
+		throw "ERROR: Unable to create the graph file.";
+
+	GraphFileHeader header;
+	std::copy(GRAPH_FILE_MAGIC, GRAPH_FILE_MAGIC + 4, header.magic);
+	header.version = GRAPH_FILE_VERSION;
+	header.numVertices = numV;
+	header.numColumns = numCol;
+	header.numEdges = offsets[numV];
+	header.reserved = 0;
+	fout.write((const char*)&header, sizeof(header));
+	for (int v = 0; v <= numV; ++v)
+	{
+		int offset = offsets[v];
+		fout.write((const char*)&offset, sizeof(offset));
+	}
+
+	// second pass: the neighbors, each row sorted
+	int* row = new int[maxDegree + 1];
+	for (int v = 0; v < numV; ++v)
+	{
+		int degree = 0;
+		g.forEachEdge(v, [&](int n) { row[degree++] = n; });
+		std::sort(row, row + degree);
+		fout.write((const char*)row, degree * sizeof(int));
+	}
+	delete[] row;
+
+	if (fout.fail())
+		throw "ERROR: Unable to write the graph file.";
+}
+
+#endif // GRAPHFILE_H
@@ -0,0 +1,173 @@
+/***********************************************************************
+ * Header:
+ *    HEAP
+ * Summary:
+ *    Priority queues of (key, value) pairs for the informed searches.
+ *    Neither has decrease-key: a search pushes a vertex again when it
+ *    finds a better key and skips the stale entries as they come off.
+ *        DaryHeap  : a d-ary min-heap. With four children per node the
+ *                    tree is half as deep as a binary heap and the
+ *                    children of a node share a cache line.
+ *        RadixHeap : a monotone bucket queue for integer keys, O(1)
+ *                    amortized per pop when keys never go backwards.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <vector>
+#include "bits.h"
+
+/*****************************************
+ * HEAP ITEM
+ * The key orders the heap; the value rides along
+ ****************************************/
+struct HeapItem
+{
+	long long key;
+	int value;
+};
+
+/*****************************************
+ * DARY HEAP
+ * The smallest key is on top. The storage is kept
+ * by clear(), so a heap that is reused allocates
+ * only while it grows.
+ ****************************************/
+template <int D = 4>
+class DaryHeap
+{
+public:
+	bool empty() const { return items.empty(); }
+	int size() const { return (int)items.size(); }
+	void clear() { items.clear(); }
+	const HeapItem& top() const { return items[0]; }
+
+	void push(long long key, int value)
+	{
+		HeapItem item = { key, value };
+		int i = (int)items.size();
+		items.push_back(item);
+
+		// move the hole up until the parent is no bigger
+		while (i > 0 && key < items[(i - 1) / D].key)
+		{
+			items[i] = items[(i - 1) / D];
+			i = (i - 1) / D;
+		}
+		items[i] = item;
+	}
+
+	void pop()
+	{
+		HeapItem last = items.back();
+		items.pop_back();
+		int n = (int)items.size();
+		if (n == 0)
+			return;
+
+		// move the hole down until no child is smaller than the last item
+		int i = 0;
+		for (;;)
+		{
+			int first = i * D + 1;
+			if (first >= n)
+				break;
+			int smallest = first;
+			int end = first + D < n ? first + D : n;
+			for (int c = first + 1; c < end; c++)
+				if (items[c].key < items[smallest].key)
+					smallest = c;
+			if (!(items[smallest].key < last.key))
+				break;
+			items[i] = items[smallest];
+			i = smallest;
+		}
+		items[i] = last;
+	}
+
+private:
+	std::vector<HeapItem> items;
+};
+
+/*****************************************
+ * RADIX HEAP
+ * A monotone priority queue for Dijkstra: no key
+ * pushed may be smaller than the last one popped,
+ * and keys must not be negative. Bucket b holds
+ * the keys whose highest bit that differs from the
+ * last key popped is bit b - 1; bucket 0 holds
+ * keys equal to it. Popping empties the first
+ * non-empty bucket into lower ones, and an item
+ * only ever moves down, so each costs O(1)
+ * amortized for integer keys.
+ ****************************************/
+class RadixHeap
+{
+public:
+	RadixHeap() : last(0), count(0) {}
+	bool empty() const { return count == 0; }
+	int size() const { return count; }
+	void clear()
+	{
+		for (int b = 0; b < NUM_BUCKETS; b++)
+			buckets[b].clear();
+		last = 0;
+		count = 0;
+	}
+
+	void push(long long key, int value)
+	{
+		HeapItem item = { key, value };
+		buckets[bucketOf(key)].push_back(item);
+		count++;
+	}
+
+	const HeapItem& top()
+	{
+		if (buckets[0].empty())
+			redistribute();
+		return buckets[0].back();
+	}
+
+	void pop()
+	{
+		if (buckets[0].empty())
+			redistribute();
+		buckets[0].pop_back();
+		count--;
+	}
+
+private:
+	enum { NUM_BUCKETS = 65 };
+
+	int bucketOf(long long key) const
+	{
+		Word differ = (Word)key ^ (Word)last;
+		return differ == 0 ? 0 : WORD_BITS - countLeadingZeros(differ);
+	}
+
+	// move the smallest keys into bucket 0
+	void redistribute()
+	{
+		int b = 1;
+		while (buckets[b].empty())
+			b++;
+		std::vector<HeapItem>& from = buckets[b];
+		last = from[0].key;
+		for (size_t i = 1; i < from.size(); i++)
+			if (from[i].key < last)
+				last = from[i].key;
+		for (size_t i = 0; i < from.size(); i++)
+			buckets[bucketOf(from[i].key)].push_back(from[i]);
+		from.clear();
+	}
+
+	std::vector<HeapItem> buckets[NUM_BUCKETS];
+	long long last;   // the last key popped
+	int count;
+};
+
+#endif // HEAP_H
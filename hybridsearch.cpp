@@ -0,0 +1,203 @@
+#include "hybridsearch.h"
+
+/*********************************************
+ * HYBRID SEARCH : CONSTRUCTOR
+ * Transpose the bit matrix and count the degrees
+ ********************************************/
+HybridSearch::HybridSearch(const DenseGraph& g) throw (const char*)
+	: g(g), numV(g.size()), rowWords(g.numRowWords()), columns(NULL),
+	  outDegree(NULL), inDegree(NULL), numEdges(0), frontier(NULL),
+	  next(NULL), visited(NULL), parents(NULL), goal(-1),
+	  topDownSteps(0), bottomUpSteps(0)
+{
+	size_t matrixWords = (size_t)numV * rowWords;
+	try
+	{
+		columns = new Word[matrixWords];
+		outDegree = new int[numV];
+		inDegree = new int[numV];
+		frontier = new Word[rowWords];
+		next = new Word[rowWords];
+		visited = new Word[rowWords];
+		parents = new int[numV];
+	}
+	catch (const std::bad_alloc)
+	{
+		release();
+		throw "ERROR: Unable to allocate memory for the search.";
+	}
+
+	for (size_t i = 0; i < matrixWords; i++)
+		columns[i] = 0;
+	for (int v = 0; v < numV; v++)
+		inDegree[v] = 0;
+	for (int u = 0; u < numV; u++)
+	{
+		const Word* r = g.row(u);
+		outDegree[u] = 0;
+		for (int w = 0; w < rowWords; w++)
+		{
+			outDegree[u] += popCount(r[w]);
+			for (Word bits = r[w]; bits; bits &= bits - 1)
+			{
+				int v = w * WORD_BITS + countTrailingZeros(bits);
+				columns[(size_t)v * rowWords + u / WORD_BITS] |= bitMask(u);
+				inDegree[v]++;
+			}
+		}
+		numEdges += outDegree[u];
+	}
+}
+
+/*********************************************
+ * HYBRID SEARCH :: RELEASE
+ * Free whatever has been allocated
+ ********************************************/
+void HybridSearch::release()
+{
+	delete[] columns;
+	delete[] outDegree;
+	delete[] inDegree;
+	delete[] frontier;
+	delete[] next;
+	delete[] visited;
+	delete[] parents;
+}
+
+/*********************************************
+ * HYBRID SEARCH :: TOP DOWN STEP
+ * Push from each frontier vertex: the new
+ * vertices are its row less everything visited.
+ * Returns true once the goal is reached.
+ ********************************************/
+bool HybridSearch::topDownStep()
+{
+	for (int fw = 0; fw < rowWords; fw++)
+		for (Word fbits = frontier[fw]; fbits; fbits &= fbits - 1)
+		{
+			int u = fw * WORD_BITS + countTrailingZeros(fbits);
+			const Word* r = g.row(u);
+			for (int w = 0; w < rowWords; w++)
+			{
+				Word fresh = r[w] & ~visited[w];
+				if (fresh == 0)
+					continue;
+				visited[w] |= fresh;
+				next[w] |= fresh;
+				for (; fresh; fresh &= fresh - 1)
+				{
+					int v = w * WORD_BITS + countTrailingZeros(fresh);
+					parents[v] = u;
+					frontierSize++;
+					frontierEdges += outDegree[v];
+					unvisitedEdges -= inDegree[v];
+				}
+			}
+		}
+	return parents[goal] != -1;
+}
+
+/*********************************************
+ * HYBRID SEARCH :: BOTTOM UP STEP
+ * Pull into each unvisited vertex: any frontier
+ * vertex in its column will do as the parent.
+ * Returns true once the goal is reached.
+ ********************************************/
+bool HybridSearch::bottomUpStep()
+{
+	for (int vw = 0; vw < rowWords; vw++)
+	{
+		Word unvisited = ~visited[vw];
+		if (vw == rowWords - 1 && numV % WORD_BITS)
+			unvisited &= bitMask(numV) - 1;
+		for (; unvisited; unvisited &= unvisited - 1)
+		{
+			int v = vw * WORD_BITS + countTrailingZeros(unvisited);
+			const Word* c = column(v);
+			for (int w = 0; w < rowWords; w++)
+			{
+				Word found = c[w] & frontier[w];
+				if (found)
+				{
+					parents[v] = w * WORD_BITS + countTrailingZeros(found);
+					next[vw] |= bitMask(v);
+					frontierSize++;
+					frontierEdges += outDegree[v];
+					unvisitedEdges -= inDegree[v];
+					break;
+				}
+			}
+		}
+	}
+
+	// visiting waits for the end of the level so the frontier stays whole
+	for (int w = 0; w < rowWords; w++)
+		visited[w] |= next[w];
+	return parents[goal] != -1;
+}
+
+/*********************************************
+ * HYBRID SEARCH :: FIND PATH
+ * Breadth-first search from v1 one level at a
+ * time, each level done whichever way is cheaper.
+ * Fills in the vertices from v1 through v2, or
+ * returns false with an empty path.
+ ********************************************/
+bool HybridSearch::findPath(const Vertex& v1, const Vertex& v2,
+                            Vector<Vertex>& path) throw (const char*)
+{
+	path.clear();
+	topDownSteps = 0;
+	bottomUpSteps = 0;
+	int start = v1.index();
+	goal = v2.index();
+	for (int w = 0; w < rowWords; w++)
+		frontier[w] = visited[w] = 0;
+	for (int v = 0; v < numV; v++)
+		parents[v] = -1;
+
+	frontier[start / WORD_BITS] |= bitMask(start);
+	visited[start / WORD_BITS] |= bitMask(start);
+	parents[start] = start;
+	int lastSize = 1;
+	frontierSize = 1;
+	frontierEdges = outDegree[start];
+	unvisitedEdges = numEdges - inDegree[start];
+	bool bottomUp = false;
+	bool found = (start == goal);
+
+	while (!found && frontierSize > 0)
+	{
+		// pick the direction of this level
+		if (!bottomUp)
+			bottomUp = frontierEdges > unvisitedEdges / HYBRID_ALPHA;
+		else
+			bottomUp = !(frontierSize < lastSize &&
+			             frontierSize < numV / HYBRID_BETA);
+
+		lastSize = frontierSize;
+		frontierSize = 0;
+		frontierEdges = 0;
+		for (int w = 0; w < rowWords; w++)
+			next[w] = 0;
+		if (bottomUp)
+		{
+			bottomUpSteps++;
+			found = bottomUpStep();
+		}
+		else
+		{
+			topDownSteps++;
+			found = topDownStep();
+		}
+		Word* tmp = frontier;
+		frontier = next;
+		next = tmp;
+	}
+	if (!found)
+		return false;
+
+	buildPath(start, goal, [this](int v) { return parents[v]; },
+	          g.getContext(), path);
+	return true;
+}
@@ -0,0 +1,87 @@
+/***********************************************************************
+ * Header:
+ *    HYBRID SEARCH
+ * Summary:
+ *    A direction-optimizing breadth-first search over the bit matrix of
+ *    a DenseGraph. The frontier and the visited set are bitmaps, so a
+ *    level can be grown a word at a time. Each level is done one of
+ *    two ways:
+ *        top-down  : every frontier vertex ORs its row into the next
+ *                    frontier, masked by the unvisited vertices
+ *        bottom-up : every unvisited vertex ANDs its column with the
+ *                    frontier and stops at the first parent found
+ *    Top-down is cheap while the frontier is small. Once the frontier
+ *    covers much of a dense graph, bottom-up checks far fewer edges.
+ *    The choice follows Beamer's heuristic: switch to bottom-up when
+ *    the frontier has more than 1/ALPHA of the edges still unexplored,
+ *    and back when it holds fewer than 1/BETA of the vertices.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef HYBRIDSEARCH_H
+#define HYBRIDSEARCH_H
+
+#include "graph.h"
+#include "bits.h"
+
+#ifndef HYBRID_ALPHA
+#define HYBRID_ALPHA 14   // top-down --> bottom-up threshold
+#endif
+#ifndef HYBRID_BETA
+#define HYBRID_BETA  24   // bottom-up --> top-down threshold
+#endif
+
+/*****************************************
+ * HYBRID SEARCH
+ * Built once per graph: it keeps the transpose of
+ * the bit matrix for the bottom-up steps, so it has
+ * to be rebuilt if edges are added afterwards. All
+ * the scratch space is allocated up front, so
+ * findPath() allocates only the path it returns.
+ ****************************************/
+class HybridSearch
+{
+public:
+	HybridSearch(const DenseGraph& g) throw (const char*);
+	~HybridSearch() { release(); }
+
+	// the same answer as BasicGraph::findPath
+	bool findPath(const Vertex& v1, const Vertex& v2, Vector<Vertex>& path)
+		throw (const char*);
+
+	// how the last search was done
+	int numTopDownSteps() const { return topDownSteps; }
+	int numBottomUpSteps() const { return bottomUpSteps; }
+
+private:
+	HybridSearch(const HybridSearch& rhs);
+	HybridSearch& operator=(const HybridSearch& rhs);
+
+	void release();
+	bool topDownStep();
+	bool bottomUpStep();
+	const Word* column(int v) const { return columns + (size_t)v * rowWords; }
+
+	const DenseGraph& g;
+	int numV;
+	int rowWords;
+	Word* columns;         // the transposed matrix: column v is every u --> v
+	int* outDegree;
+	int* inDegree;
+	long long numEdges;
+
+	Word* frontier;
+	Word* next;
+	Word* visited;
+	int* parents;
+	int frontierSize;
+	long long frontierEdges; // edges out of the frontier
+	long long unvisitedEdges;// edges into unvisited vertices
+	int goal;
+
+	int topDownSteps;
+	int bottomUpSteps;
+};
+
+#endif // HYBRIDSEARCH_H
@@ -0,0 +1,189 @@
+#include <cstdlib>
+#include "jumpsearch.h"
+#include "astar.h"
+
+/*********************************************
+ * STEP
+ * The cell next to v in direction d
+ ********************************************/
+static inline int step(int v, int d, int numCol)
+{
+	switch (d)
+	{
+	case GridStorage::NORTH: return v - numCol;
+	case GridStorage::SOUTH: return v + numCol;
+	case GridStorage::EAST:  return v + 1;
+	default:                 return v - 1;
+	}
+}
+
+/*********************************************
+ * IS FORCED
+ * Coming into x horizontally from p, is the turn
+ * to vd a forced neighbor? It is unless p could
+ * have gone vd first and then across.
+ ********************************************/
+static inline bool isForced(const GridGraph& g, int p, int x, int hd, int vd)
+{
+	GridStorage::Direction across = (GridStorage::Direction)hd;
+	GridStorage::Direction turn = (GridStorage::Direction)vd;
+	return g.isOpen(x, turn) &&
+	       !(g.isOpen(p, turn) && g.isOpen(step(p, vd, g.numColumns()), across));
+}
+
+/*********************************************
+ * JUMP HORIZONTAL
+ * Run from v in direction hd until the goal, a
+ * cell with a forced neighbor, or a wall. Returns
+ * the jump point, or -1 for a dead end.
+ ********************************************/
+static int jumpHorizontal(const GridGraph& g, int v, int hd, int goal)
+{
+	int numCol = g.numColumns();
+	while (g.isOpen(v, (GridStorage::Direction)hd))
+	{
+		int x = step(v, hd, numCol);
+		if (x == goal ||
+		    isForced(g, v, x, hd, GridStorage::NORTH) ||
+		    isForced(g, v, x, hd, GridStorage::SOUTH))
+			return x;
+		v = x;
+	}
+	return -1;
+}
+
+/*********************************************
+ * JUMP VERTICAL
+ * Run from v in direction vd. A cell is a jump
+ * point if it is the goal or if a horizontal run
+ * from it finds one. Returns -1 for a dead end.
+ ********************************************/
+static int jumpVertical(const GridGraph& g, int v, int vd, int goal)
+{
+	int numCol = g.numColumns();
+	while (g.isOpen(v, (GridStorage::Direction)vd))
+	{
+		v = step(v, vd, numCol);
+		if (v == goal ||
+		    jumpHorizontal(g, v, GridStorage::EAST, goal) != -1 ||
+		    jumpHorizontal(g, v, GridStorage::WEST, goal) != -1)
+			return v;
+	}
+	return -1;
+}
+
+/*********************************************
+ * FIND PATH JUMP POINT
+ * A* over jump points with the Manhattan estimate.
+ * The parent of a jump point is the jump point it
+ * was reached from, always along one row or one
+ * column, which tells both the way it was entered
+ * and how to fill in the cells between. A cell
+ * entered vertically may turn more ways than one
+ * entered horizontally, so a tie in distance is
+ * settled in favor of the vertical way in.
+ ********************************************/
+bool findPathJumpPoint(const GridGraph& g, const Vertex& v1, const Vertex& v2,
+                       SearchWorkspace& ws, Vector<Vertex>& path)
+	throw (const char*)
+{
+	ws.begin(g.size());
+	path.clear();
+
+	int numCol = g.numColumns();
+	int start = v1.index();
+	int goal = v2.index();
+	ManhattanHeuristic estimate(g.getContext(), goal);
+	auto keyOf = [](int distance, int total)
+	{
+		return ((long long)total << 32) - distance;
+	};
+	auto isVertical = [&](int v, int parent)
+	{
+		return v != parent && v % numCol == parent % numCol;
+	};
+
+	DaryHeap<4>& open = ws.heap();
+	ws.visit(start, start, 0);
+	open.push(keyOf(0, estimate(start)), start);
+	bool found = false;
+	while (!open.empty())
+	{
+		HeapItem item = open.top();
+		open.pop();
+		int v = item.value;
+		int d = ws.distance(v);
+		if (item.key != keyOf(d, d + estimate(v)))
+			continue;
+		if (v == goal)
+		{
+			found = true;
+			break;
+		}
+		ws.expand();
+		ws.close(v);
+
+		// the directions worth trying depend on the way in
+		int parent = ws.predecessor(v);
+		int directions;
+		if (v == parent)
+			directions = GridStorage::NORTH | GridStorage::SOUTH |
+			             GridStorage::EAST | GridStorage::WEST;
+		else if (isVertical(v, parent))
+			directions = (parent < v ? GridStorage::SOUTH : GridStorage::NORTH) |
+			             GridStorage::EAST | GridStorage::WEST;
+		else
+		{
+			int hd = parent < v ? GridStorage::EAST : GridStorage::WEST;
+			int p = step(v, hd == GridStorage::EAST ? GridStorage::WEST :
+			                                          GridStorage::EAST, numCol);
+			directions = hd;
+			if (isForced(g, p, v, hd, GridStorage::NORTH))
+				directions |= GridStorage::NORTH;
+			if (isForced(g, p, v, hd, GridStorage::SOUTH))
+				directions |= GridStorage::SOUTH;
+		}
+
+		for (int dir = GridStorage::NORTH; dir <= GridStorage::WEST; dir <<= 1)
+		{
+			if (!(directions & dir))
+				continue;
+			bool vertical = (dir == GridStorage::NORTH || dir == GridStorage::SOUTH);
+			int n = vertical ? jumpVertical(g, v, dir, goal) :
+			                   jumpHorizontal(g, v, dir, goal);
+			if (n == -1)
+				continue;
+			int dn = d + abs(n / numCol - v / numCol) + abs(n % numCol - v % numCol);
+			if (!ws.isVisited(n) || dn < ws.distance(n))
+			{
+				ws.visit(n, v, dn);
+				open.push(keyOf(dn, dn + estimate(n)), n);
+			}
+			else if (dn == ws.distance(n) && vertical &&
+			         !isVertical(n, ws.predecessor(n)))
+			{
+				// the same distance, but a vertical way in opens more
+				// directions. Still waiting, its entry on the heap holds;
+				// already expanded, it has to go again for the new ones.
+				bool expanded = ws.isClosed(n);
+				ws.visit(n, v, dn);
+				if (expanded)
+					open.push(keyOf(dn, dn + estimate(n)), n);
+			}
+		}
+	}
+	if (!found)
+		return false;
+
+	// step back cell by cell toward the jump point each run started from
+	int jump = goal;
+	buildPath(start, goal, [&](int v)
+	{
+		if (v == jump)
+			jump = ws.predecessor(v);
+		if (v % numCol == jump % numCol)
+			return jump < v ? v - numCol : v + numCol;
+		return jump < v ? v - 1 : v + 1;
+	}, g.getContext(), path);
+	return true;
+}
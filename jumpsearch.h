@@ -0,0 +1,29 @@
+/***********************************************************************
+ * Header:
+ *    JUMP SEARCH
+ * Summary:
+ *    Jump point search on a four-connected maze grid. In an open room
+ *    there are many shortest paths that differ only in the order of
+ *    their moves, and A* expands all of them. Jump point search only
+ *    follows one order: vertical moves as early as possible. A
+ *    horizontal run may only turn where the turn could not have been
+ *    taken a step earlier (a forced neighbor); a vertical run may
+ *    turn anywhere. Runs are followed cell by cell without touching
+ *    the heap, and only the cells where the search has a real choice,
+ *    the jump points, are pushed on it.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef JUMPSEARCH_H
+#define JUMPSEARCH_H
+
+#include "graph.h"
+#include "search.h"
+
+// a shortest path from v1 to v2 on a maze grid, the same length as findPath
+bool findPathJumpPoint(const GridGraph& g, const Vertex& v1, const Vertex& v2,
+                       SearchWorkspace& ws, Vector<Vertex>& path)
+	throw (const char*);
+
+#endif // JUMPSEARCH_H
@@ -0,0 +1,73 @@
+#include "landmarks.h"
+
+const int Landmarks::UNREACHED;
+
+/*********************************************
+ * CHOOSE LANDMARKS
+ * On a maze grid walk the border clockwise from
+ * the top left corner and take evenly spaced
+ * cells, which puts four landmarks on the four
+ * corners of a square maze. Any other graph, and
+ * a grid one cell thin, takes evenly spaced
+ * indices instead.
+ ********************************************/
+void chooseLandmarks(const VertexContext& context, int numVertices,
+                     int numLandmarks, std::vector<int>& landmarks)
+{
+	landmarks.clear();
+	if (numLandmarks > numVertices)
+		numLandmarks = numVertices;
+	int numCol = context.maxCol;
+	int numRow = numCol > 0 ? numVertices / numCol : 0;
+	if (numCol < 2 || numRow < 2)
+	{
+		for (int i = 0; i < numLandmarks; i++)
+			landmarks.push_back((int)((long long)i * numVertices / numLandmarks));
+		return;
+	}
+
+	int border = 2 * (numCol + numRow) - 4;
+	if (numLandmarks > border)
+		numLandmarks = border;
+	for (int i = 0; i < numLandmarks; i++)
+	{
+		int step = (int)((long long)i * border / numLandmarks);
+		int col;
+		int row;
+		if (step < numCol - 1)                         // along the top
+		{
+			col = step;
+			row = 0;
+		}
+		else if ((step -= numCol - 1) < numRow - 1)    // down the right
+		{
+			col = numCol - 1;
+			row = step;
+		}
+		else if ((step -= numRow - 1) < numCol - 1)    // back along the bottom
+		{
+			col = numCol - 1 - step;
+			row = numRow - 1;
+		}
+		else                                           // up the left
+		{
+			col = 0;
+			row = numRow - 1 - (step - (numCol - 1));
+		}
+		landmarks.push_back(row * numCol + col);
+	}
+}
+
+/*********************************************
+ * LANDMARK HEURISTIC : CONSTRUCTOR
+ * Look up the goal's distances once per query
+ ********************************************/
+LandmarkHeuristic::LandmarkHeuristic(const Landmarks& landmarks, int goal)
+	: landmarks(landmarks), fromGoal(landmarks.size()), toGoal(landmarks.size())
+{
+	for (int i = 0; i < landmarks.size(); i++)
+	{
+		fromGoal[i] = landmarks.distanceFrom(i, goal);
+		toGoal[i] = landmarks.distanceTo(i, goal);
+	}
+}
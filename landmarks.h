@@ -0,0 +1,206 @@
+/***********************************************************************
+ * Header:
+ *    LANDMARKS
+ * Summary:
+ *    ALT: A* with landmarks and the triangle inequality. A few vertices
+ *    are picked as landmarks and the hops from each to every vertex, and
+ *    from every vertex to each, are worked out ahead of time. Getting
+ *    from L to the goal takes no more than going from L to v and then
+ *    on to the goal, so d(L,goal) - d(L,v) can never overestimate the
+ *    hops from v to the goal, and likewise d(v,L) - d(goal,L). The
+ *    best of these bounds follows the walls of a maze where Manhattan
+ *    distance cuts straight through them, so A* expands far fewer
+ *    vertices. It pays off when many queries share one unchanging
+ *    graph.
+ *        Landmarks           : the landmarks and their distance tables
+ *        LandmarkHeuristic   : the estimate to one goal, for findPathAStar
+ *        findPathLandmarks() : a shortest path from v1 to v2
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <new>
+#include <vector>
+#include <functional>
+#include "graph.h"
+#include "search.h"
+#include "astar.h"
+#include "bidirectional.h"
+#include "threadpool.h"
+
+// spread numLandmarks vertices over a graph: around the border of a
+// maze grid, where they see the most detours, or evenly by index
+void chooseLandmarks(const VertexContext& context, int numVertices,
+                     int numLandmarks, std::vector<int>& landmarks);
+
+class LandmarkHeuristic;
+
+/*****************************************
+ * LANDMARKS
+ * numLandmarks distances per vertex each way,
+ * stored together per vertex so an estimate reads
+ * one run of memory. When every edge goes both
+ * ways the two directions are the same and only
+ * one table is kept. Built from a snapshot: add
+ * no edges to the graph while it is in use.
+ ****************************************/
+class Landmarks
+{
+public:
+	template <class G>
+	Landmarks(const G& g, int numLandmarks, ThreadPool& pool)
+		throw (const char*);
+
+	int size() const { return (int)landmarks.size(); }
+	int landmark(int i) const { return landmarks[i]; }
+
+	// hops from landmark i to v, or from v to landmark i; UNREACHED if none
+	int distanceFrom(int i, int v) const { return from[(size_t)v * size() + i]; }
+	int distanceTo(int i, int v) const
+	{
+		return (symmetric ? from : to)[(size_t)v * size() + i];
+	}
+
+	static const int UNREACHED = -1;
+
+private:
+	template <class G>
+	void breadthFirst(const G& g, int source, std::vector<int>& table,
+	                  int column, std::vector<int>& queue) const;
+
+	std::vector<int> landmarks;
+	std::vector<int> from;   // from[v * size() + i] = d(landmark i, v)
+	std::vector<int> to;     // to[v * size() + i]   = d(v, landmark i)
+	bool symmetric;
+};
+
+/*****************************************
+ * LANDMARK HEURISTIC
+ * The largest triangle-inequality bound to one
+ * goal, for findPathAStar. A landmark that cannot
+ * reach, or be reached from, either end gives no
+ * bound.
+ ****************************************/
+class LandmarkHeuristic
+{
+public:
+	LandmarkHeuristic(const Landmarks& landmarks, int goal);
+	int operator()(int v) const
+	{
+		int best = 0;
+		for (int i = 0; i < landmarks.size(); i++)
+		{
+			int fromV = landmarks.distanceFrom(i, v);
+			if (fromGoal[i] != Landmarks::UNREACHED &&
+			    fromV != Landmarks::UNREACHED && fromGoal[i] - fromV > best)
+				best = fromGoal[i] - fromV;
+			int toV = landmarks.distanceTo(i, v);
+			if (toGoal[i] != Landmarks::UNREACHED &&
+			    toV != Landmarks::UNREACHED && toV - toGoal[i] > best)
+				best = toV - toGoal[i];
+		}
+		return best;
+	}
+
+private:
+	const Landmarks& landmarks;
+	std::vector<int> fromGoal;   // d(landmark i, goal)
+	std::vector<int> toGoal;     // d(goal, landmark i)
+};
+
+/*********************************************
+ * LANDMARKS : CONSTRUCTOR
+ * Choose the landmarks, then run one plain
+ * breadth-first search per landmark and
+ * direction, all at once on the pool. The
+ * searches against the edges run on the
+ * transpose, unless every edge has its reverse.
+ ********************************************/
+template <class G>
+Landmarks::Landmarks(const G& g, int numLandmarks, ThreadPool& pool)
+	throw (const char*) : symmetric(true)
+{
+	g.pack();
+	int numV = g.size();
+	chooseLandmarks(g.getContext(), numV, numLandmarks, landmarks);
+	for (int v = 0; v < numV && symmetric; v++)
+		g.forEachEdge(v, [&](int n)
+		{
+			if (!g.hasEdge(n, v))
+				symmetric = false;
+		});
+
+	int k = size();
+	try
+	{
+		from.assign((size_t)numV * k, UNREACHED);
+		if (!symmetric)
+			to.assign((size_t)numV * k, UNREACHED);
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the landmarks.";
+	}
+
+	CsrGraph reverse(0);
+	if (!symmetric)
+		reverse = transpose(g);
+	std::vector< std::vector<int> > queues(pool.size());
+	std::function<void (int, int)> search = [&](int task, int thread)
+	{
+		if (task < k)
+			breadthFirst(g, landmarks[task], from, task, queues[thread]);
+		else
+			breadthFirst(reverse, landmarks[task - k], to, task - k,
+			             queues[thread]);
+	};
+	pool.run(symmetric ? k : 2 * k, search);
+}
+
+/*********************************************
+ * LANDMARKS :: BREADTH FIRST
+ * Fill one column of a table with the hops from
+ * source, using the caller's queue
+ ********************************************/
+template <class G>
+void Landmarks::breadthFirst(const G& g, int source, std::vector<int>& table,
+                             int column, std::vector<int>& queue) const
+{
+	int k = size();
+	queue.clear();
+	queue.push_back(source);
+	table[(size_t)source * k + column] = 0;
+	for (size_t head = 0; head < queue.size(); head++)
+	{
+		int v = queue[head];
+		int d = table[(size_t)v * k + column] + 1;
+		g.forEachEdge(v, [&](int n)
+		{
+			int& entry = table[(size_t)n * k + column];
+			if (entry == UNREACHED)
+			{
+				entry = d;
+				queue.push_back(n);
+			}
+		});
+	}
+}
+
+/*********************************************
+ * FIND PATH LANDMARKS
+ * A* guided by the landmarks. The path is as
+ * short as BasicGraph::findPath finds.
+ ********************************************/
+template <class G>
+bool findPathLandmarks(const G& g, const Vertex& v1, const Vertex& v2,
+                       const Landmarks& landmarks, SearchWorkspace& ws,
+                       Vector<Vertex>& path) throw (const char*)
+{
+	return findPathAStar(g, v1, v2, LandmarkHeuristic(landmarks, v2.index()),
+	                     ws, path);
+}
+
+#endif // LANDMARKS_H
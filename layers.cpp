@@ -0,0 +1,137 @@
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include "layers.h"
+#include "bidirectional.h"
+
+/*********************************************
+ * TOPOLOGICAL LAYERS :: BUILD
+ * Count what every vertex waits on, then peel
+ * the layers. The threads take slices of the
+ * current layer and, for every vertex in it,
+ * knock one off the count of each vertex that
+ * depends on it, found in the transpose. The
+ * vertices they free are gathered per thread
+ * and appended as the next layer.
+ ********************************************/
+void TopologicalLayers::build(const CsrGraph& dependencies, ThreadPool& pool)
+	throw (const char*)
+{
+	int numV = dependencies.size();
+	CsrGraph dependents = transpose(dependencies);
+	std::vector< std::atomic<int> > waiting(numV);
+	layerNumbers.assign(numV, -1);
+	order.reserve(numV);
+	for (int v = 0; v < numV; v++)
+	{
+		int count = 0;
+		dependencies.forEachEdge(v, [&](int n) { count++; });
+		waiting[v].store(count, std::memory_order_relaxed);
+		if (count == 0)
+		{
+			layerNumbers[v] = 0;
+			order.push_back(v);
+		}
+	}
+	layerOffsets.push_back(0);
+
+	std::vector< std::vector<int> > buffers(pool.size());
+	int begin = 0;
+	int end = (int)order.size();
+	int level = 0;
+	std::function<void (int, int)> release = [&](int task, int thread)
+	{
+		std::vector<int>& buffer = buffers[thread];
+		int last = std::min(end, begin + (task + 1) * PARALLEL_GRAIN);
+		for (int i = begin + task * PARALLEL_GRAIN; i < last; i++)
+			dependents.forEachEdge(order[i], [&](int d)
+			{
+				if (waiting[d].fetch_sub(1, std::memory_order_relaxed) == 1)
+				{
+					layerNumbers[d] = level;
+					buffer.push_back(d);
+				}
+			});
+	};
+
+	while (begin < end)
+	{
+		std::sort(order.begin() + begin, order.end());
+		layerOffsets.push_back(end);
+		level++;
+		int numTasks = (end - begin + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+		if (numTasks == 1)
+			release(0, 0);
+		else
+			pool.run(numTasks, release);
+		for (size_t t = 0; t < buffers.size(); t++)
+		{
+			order.insert(order.end(), buffers[t].begin(), buffers[t].end());
+			buffers[t].clear();
+		}
+		begin = end;
+		end = (int)order.size();
+	}
+
+	findCriticalPath(dependencies);
+	if (numLayered() < numV)
+		findCycle(dependencies);
+}
+
+/*********************************************
+ * TOPOLOGICAL LAYERS :: FIND CRITICAL PATH
+ * A vertex lands in a layer the step after its
+ * last dependency, so from any vertex in the
+ * last layer there is always a dependency one
+ * layer down to step back to
+ ********************************************/
+void TopologicalLayers::findCriticalPath(const CsrGraph& dependencies)
+{
+	critical.clear();
+	if (numLayers() == 0)
+		return;
+	int v = layer(numLayers() - 1)[0];
+	critical.push_back(v);
+	for (int level = numLayers() - 2; level >= 0; level--)
+	{
+		int next = -1;
+		dependencies.forEachEdge(v, [&](int n)
+		{
+			if (next == -1 && layerNumbers[n] == level)
+				next = n;
+		});
+		v = next;
+		critical.push_back(v);
+	}
+	std::reverse(critical.begin(), critical.end());
+}
+
+/*********************************************
+ * TOPOLOGICAL LAYERS :: FIND CYCLE
+ * A vertex left out is still waiting on some
+ * dependency that was left out too, so walking
+ * from one left out vertex to such a dependency
+ * must come back to a vertex already on the
+ * walk. From there to here is a cycle.
+ ********************************************/
+void TopologicalLayers::findCycle(const CsrGraph& dependencies)
+{
+	std::vector<int> step(numVertices(), -1);   // place on the walk
+	std::vector<int> walk;
+	int v = 0;
+	while (layerNumbers[v] != -1)
+		v++;
+	while (step[v] == -1)
+	{
+		step[v] = (int)walk.size();
+		walk.push_back(v);
+		int next = -1;
+		dependencies.forEachEdge(v, [&](int n)
+		{
+			if (next == -1 && layerNumbers[n] == -1)
+				next = n;
+		});
+		v = next;
+	}
+	cycleVertices.assign(walk.begin() + step[v], walk.end());
+}
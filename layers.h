@@ -0,0 +1,93 @@
+/***********************************************************************
+ * Header:
+ *    LAYERS
+ * Summary:
+ *    A topological layering of a dependency graph, where an edge
+ *    v --> n means v depends on n, the way the course graph points
+ *    from a class to its prerequisites. Layer 0 holds everything that
+ *    depends on nothing, and each later layer everything whose last
+ *    dependency was in the layer before, so for the courses the layers
+ *    are the semesters of the fastest schedule and their number is the
+ *    length of the longest chain of prerequisites.
+ *
+ *    It is Kahn's algorithm one layer at a time on a ThreadPool. Every
+ *    vertex counts the dependencies it is still waiting on, and the
+ *    thread whose decrement brings a count to zero puts that vertex in
+ *    the next layer, so no vertex is ever claimed twice.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef LAYERS_H
+#define LAYERS_H
+
+#include <vector>
+#include "graph.h"
+#include "threadpool.h"
+
+/*****************************************
+ * TOPOLOGICAL LAYERS
+ * Worked out once from a copy of the edges.
+ * Vertices on a cycle, or depending on one, are
+ * never ready and are left out of the layers;
+ * cycle() gives one of the cycles holding them
+ * up.
+ ****************************************/
+class TopologicalLayers
+{
+public:
+	template <class G>
+	TopologicalLayers(const G& g, ThreadPool& pool) throw (const char*);
+
+	int numVertices() const { return (int)layerNumbers.size(); }
+	int numLayers() const { return (int)layerOffsets.size() - 1; }
+
+	// the vertices of a layer, in increasing order
+	int layerSize(int i) const { return layerOffsets[i + 1] - layerOffsets[i]; }
+	const int* layer(int i) const { return &order[layerOffsets[i]]; }
+
+	// the layer of v, or -1 when a cycle keeps it out
+	int layerOf(int v) const { return layerNumbers[v]; }
+	int layerOf(const Vertex& v) const { return layerNumbers[v.index()]; }
+	int numLayered() const { return layerOffsets.back(); }
+
+	// a longest chain of dependencies, one vertex from each layer
+	// starting with layer 0; it has numLayers() vertices
+	int criticalPathLength() const { return numLayers(); }
+	const std::vector<int>& criticalPath() const { return critical; }
+
+	// a cycle of dependencies, each vertex depending on the next and
+	// the last on the first, or empty when there is none
+	bool hasCycle() const { return !cycleVertices.empty(); }
+	const std::vector<int>& cycle() const { return cycleVertices; }
+
+private:
+	void build(const CsrGraph& dependencies, ThreadPool& pool)
+		throw (const char*);
+	void findCriticalPath(const CsrGraph& dependencies);
+	void findCycle(const CsrGraph& dependencies);
+
+	std::vector<int> order;         // the layers one after the other
+	std::vector<int> layerOffsets;  // layer i is order[offsets[i] .. [i + 1])
+	std::vector<int> layerNumbers;
+	std::vector<int> critical;
+	std::vector<int> cycleVertices;
+};
+
+/*********************************************
+ * TOPOLOGICAL LAYERS : CONSTRUCTOR
+ * Copy the edges of g into compressed rows and
+ * lay them out
+ ********************************************/
+template <class G>
+TopologicalLayers::TopologicalLayers(const G& g, ThreadPool& pool)
+	throw (const char*)
+{
+	CsrGraph dependencies(g.size());
+	for (int v = 0; v < g.size(); v++)
+		g.forEachEdge(v, [&](int n) { dependencies.addEdge(v, n); });
+	dependencies.pack();
+	build(dependencies, pool);
+}
+
+#endif // LAYERS_H
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include "mapfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/*********************************************
+ * MAPPED FILE :: OPEN
+ * Map the whole file read-only. Throws if the
+ * file cannot be opened, is empty, or cannot be
+ * mapped.
+ ********************************************/
+void MappedFile::open(const char* fileName) throw (const char*)
+{
+   close();
+
+#ifdef _WIN32
+   HANDLE hFile = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+   if (hFile == INVALID_HANDLE_VALUE)
+      throw "ERROR: Unable to open the file.";
+   LARGE_INTEGER length;
+   if (!GetFileSizeEx(hFile, &length) || length.QuadPart == 0)
+   {
+      CloseHandle(hFile);
+      throw "ERROR: Unable to map an empty file.";
+   }
+   HANDLE hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+   const void* p = hMapping ? MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0)
+                            : NULL;
+   if (p == NULL)
+   {
+      if (hMapping)
+         CloseHandle(hMapping);
+      CloseHandle(hFile);
+      throw "ERROR: Unable to map the file.";
+   }
+   handle   = hFile;
+   mapping  = hMapping;
+   numBytes = (size_t)length.QuadPart;
+   pData    = (const char*)p;
+#else
+   int fd = ::open(fileName, O_RDONLY);
+   if (fd < 0)
+      throw "ERROR: Unable to open the file.";
+   struct stat info;
+   if (fstat(fd, &info) != 0 || info.st_size == 0)
+   {
+      ::close(fd);
+      throw "ERROR: Unable to map an empty file.";
+   }
+   void* p = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   ::close(fd);   // the mapping keeps its own reference to the file
+   if (p == MAP_FAILED)
+      throw "ERROR: Unable to map the file.";
+   numBytes = (size_t)info.st_size;
+   pData    = (const char*)p;
+#endif
+}
+
+/*********************************************
+ * MAPPED FILE :: CLOSE
+ * Release the mapping, if there is one
+ ********************************************/
+void MappedFile::close()
+{
+   if (pData == NULL)
+      return;
+#ifdef _WIN32
+   UnmapViewOfFile(pData);
+   CloseHandle((HANDLE)mapping);
+   CloseHandle((HANDLE)handle);
+   mapping = NULL;
+   handle  = NULL;
+#else
+   munmap((void*)pData, numBytes);
+#endif
+   pData    = NULL;
+   numBytes = 0;
+}
+
+/*********************************************
+ * MAPPED FILE :: SWAP
+ * Trade mappings, so a file can be opened and
+ * checked on the side before it replaces this one
+ ********************************************/
+void MappedFile::swap(MappedFile& rhs)
+{
+   std::swap(pData,    rhs.pData);
+   std::swap(numBytes, rhs.numBytes);
+   std::swap(handle,   rhs.handle);
+   std::swap(mapping,  rhs.mapping);
+}
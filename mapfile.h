@@ -0,0 +1,46 @@
+/***********************************************************************
+ * Header:
+ *    MAP FILE
+ * Summary:
+ *    A read-only view of a whole file mapped into memory. Pages are
+ *    brought in by the operating system as they are touched, so opening
+ *    even a very large file costs almost nothing.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include <cstddef>
+
+/*****************************************
+ * MAPPED FILE
+ * Owns one read-only mapping. Not copyable;
+ * open the file again for a second view.
+ ****************************************/
+class MappedFile
+{
+public:
+   MappedFile() : pData(NULL), numBytes(0), handle(NULL), mapping(NULL) {}
+   ~MappedFile() { close(); }
+
+   void open(const char* fileName) throw (const char*);
+   void close();
+   void swap(MappedFile& rhs);
+
+   bool isOpen()        const { return pData != NULL; }
+   const char* data()   const { return pData;         }
+   size_t size()        const { return numBytes;      }
+
+private:
+   MappedFile(const MappedFile& rhs);
+   MappedFile& operator = (const MappedFile& rhs);
+
+   const char* pData;
+   size_t numBytes;
+   void* handle;      // Windows only: the file and mapping handles
+   void* mapping;
+};
+
+#endif // MAPFILE_H
@@ -12,12 +12,17 @@
 #include <fstream>
 #include <string>
 #include <cassert>
+#include <climits>
 #include "maze.h"
 #include "vertex.h"
 #include "graph.h"
 #include <set>
 #include "set.h"
 #include "vector.h"
+#include "scanner.h"
+#include "mapfile.h"
+#include "deadend.h"
+#include <vector>
 
 using std::cout;
 using std::cin;
@@ -26,16 +31,34 @@ using std::ifstream;
 //using std::set;
 //using custom::vector;
 
+/**********************************************
+ * IS LINKED
+ * Is there a tunnel between two cells, in either
+ * direction? A grid keeps its walls undirected so
+ * it can answer with a single lookup.
+ *********************************************/
+template <class G>
+inline bool isLinked(const G& g, const CVertex& v1, const CVertex& v2)
+{
+   return g.isEdge(v1, v2) || g.isEdge(v2, v1);
+}
+
+inline bool isLinked(const GridGraph& g, const CVertex& v1, const CVertex& v2)
+{
+   return g.isEdge(v1, v2);
+}
+
 /**********************************************
  * DRAW MAZE ROW
  * Draw all the horizontal tunnels on a given row
  *********************************************/
-void drawMazeRow(const Graph& g, int row, set <CVertex>& s)
+template <class G>
+void drawMazeRow(const G& g, int row, set <CVertex>& s)
 {
    const char* space = NULL;
    
-   CVertex vFrom;
-   CVertex vTo;
+   CVertex vFrom(g.getContext());
+   CVertex vTo(g.getContext());
    assert(g.size() == vFrom.getMaxCol() * vFrom.getMaxRow());
 
    // they all start with a #
@@ -50,7 +73,7 @@ void drawMazeRow(const Graph& g, int row, set <CVertex>& s)
       space = (s.end() == s.find(vTo) ? "  " : "##");
       
       // draw
-      if (g.isEdge(vFrom, vTo) || g.isEdge(vTo, vFrom))
+      if (isLinked(g, vFrom, vTo))
          cout << space << ' ';
       else
          cout << space << '|';
@@ -66,10 +89,11 @@ void drawMazeRow(const Graph& g, int row, set <CVertex>& s)
  * DRAW MAZE COLUMN
  * Draw all the vertical tunnels on a given row
  *********************************************/
-void drawMazeColumn(const Graph& g, int row, const set<CVertex>& s)
+template <class G>
+void drawMazeColumn(const G& g, int row, const set<CVertex>& s)
 {
-   CVertex vFrom;
-   CVertex vTo;
+   CVertex vFrom(g.getContext());
+   CVertex vTo(g.getContext());
    assert(g.size() == vFrom.getMaxCol() * vFrom.getMaxRow());
 
    // they all start with a #
@@ -83,7 +107,7 @@ void drawMazeColumn(const Graph& g, int row, const set<CVertex>& s)
       vTo.set(col, row + 1);
 
       // draw
-      if (g.isEdge(vFrom, vTo) || g.isEdge(vTo, vFrom))
+      if (isLinked(g, vFrom, vTo))
          cout << "  +";
       else
          cout << "--+";
@@ -100,9 +124,10 @@ void drawMazeColumn(const Graph& g, int row, const set<CVertex>& s)
  *    g     - the graph containing the maze
  *    path  - the path from the upper left corner to the lower right
  ***********************************************/
-void drawMaze(const Graph& g, const Vector<Vertex>& path)
+template <class G>
+void drawMaze(const G& g, const Vector<Vertex>& path)
 {
-   CVertex v;
+   CVertex v(g.getContext());
 
    // copy everything into a set
    set <CVertex> s;
@@ -133,41 +158,233 @@ void drawMaze(const Graph& g, const Vector<Vertex>& path)
 
 /*********************************************
  * READ MAZE
- * Read a maze from the file
+ * Read a maze from the file. The coordinates are
+ * decoded straight out of the scanner's buffer
+ * and fed to the graph as indices.
  ********************************************/
-Graph readMaze(const char* fileName)
+template <class G>
+G readMaze(const char* fileName)
 {
    // attempt to open the file
-   ifstream fin (fileName);
-   if (fin.fail())
+   Scanner fin;
+   if (!fin.open(fileName))
    {
       cout << "ERROR: Unable to open file " << fileName << endl;
-      return Graph(1);
+      return G(1);
    }
 
    // read the size from the beginning of the maze
+   const char* token;
+   int length;
    int numCol;
    int numRow;
-   fin >> numCol >> numRow;
-   CVertex vFrom;
-   CVertex vTo;
-   vFrom.setMax(numCol, numRow);
+   if (!fin.next(token, length) || !parseInt(token, length, numCol) ||
+       !fin.next(token, length) || !parseInt(token, length, numRow) ||
+       numCol == 0 || numRow == 0 || numCol > INT_MAX / numRow)
+   {
+      cout << "ERROR: Unable to read the size of the maze in "
+           << fileName << endl;
+      return G(1);
+   }
 
    // now read all the items and put them into the Graph
-   Graph g(vFrom.getMax());
-   while (fin >> vFrom >> vTo)
-      g.add(vFrom, vTo);
+   G g(numCol * numRow, numCol);
+   int from;
+   int to;
+   while (fin.next(token, length) &&
+          parseCoordinate(token, length, numCol, numRow, from) &&
+          fin.next(token, length) &&
+          parseCoordinate(token, length, numCol, numRow, to))
+      g.addEdge(from, to);
 
    // all done!
    fin.close();
+   g.pack();
    return g;
+}
+
+/*********************************************
+ * MERGE EDGES
+ * Add the edges parsed from each chunk to the
+ * graph, in file order. A CsrGraph builds its
+ * rows on the pool instead.
+ ********************************************/
+template <class G>
+void mergeEdges(G& g, const std::vector<int>* lists, int numLists,
+                ThreadPool& pool)
+{
+   for (int list = 0; list < numLists; list++)
+      for (size_t i = 0; i + 1 < lists[list].size(); i += 2)
+         g.addEdge(lists[list][i], lists[list][i + 1]);
+}
 
+inline void mergeEdges(CsrGraph& g, const std::vector<int>* lists,
+                       int numLists, ThreadPool& pool)
+{
+   g.assign(lists, numLists, pool);
+}
+
+/*********************************************
+ * READ MAZE (parallel)
+ * Map the file, split it at line boundaries into
+ * a few chunks per thread, parse the chunks on the
+ * pool into their own edge buffers, then merge.
+ * The result is the same graph the serial
+ * readMaze gives, including stopping at the first
+ * token that is not a coordinate.
+ ********************************************/
+template <class G>
+G readMaze(const char* fileName, ThreadPool& pool)
+{
+   // attempt to open the file
+   MappedFile file;
+   try
+   {
+      file.open(fileName);
+   }
+   catch (const char* error)
+   {
+      cout << "ERROR: Unable to open file " << fileName << endl;
+      return G(1);
+   }
+
+   // read the size from the beginning of the maze
+   Scanner fin;
+   fin.open(file.data(), file.data() + file.size());
+   const char* token;
+   int length;
+   int numCol;
+   int numRow;
+   if (!fin.next(token, length) || !parseInt(token, length, numCol) ||
+       !fin.next(token, length) || !parseInt(token, length, numRow) ||
+       numCol == 0 || numRow == 0 || numCol > INT_MAX / numRow)
+   {
+      cout << "ERROR: Unable to read the size of the maze in "
+           << fileName << endl;
+      return G(1);
+   }
+
+   // split the rest of the file just after a newline
+   const char* begin = fin.position();
+   const char* end = file.data() + file.size();
+   int numChunks = pool.size() * 4;
+   std::vector<const char*> bounds(numChunks + 1);
+   bounds[0] = begin;
+   for (int chunk = 1; chunk < numChunks; chunk++)
+   {
+      const char* p = begin + (end - begin) * chunk / numChunks;
+      if (p < bounds[chunk - 1])
+         p = bounds[chunk - 1];
+      while (p < end && *p != '\n')
+         p++;
+      bounds[chunk] = (p < end ? p + 1 : end);
+   }
+   bounds[numChunks] = end;
+
+   // parse every chunk into its own list of (from, to) pairs, noting
+   // why any chunk stopped early
+   const char BAD_TOKEN = 1;
+   const char SPLIT_PAIR = 2;
+   std::vector< std::vector<int> > lists(numChunks);
+   std::vector<char> stopped(numChunks, 0);
+   pool.run(numChunks, [&](int chunk, int thread)
+   {
+      Scanner chunkIn;
+      chunkIn.open(bounds[chunk], bounds[chunk + 1]);
+      const char* token;
+      int length;
+      int from;
+      int to;
+      while (chunkIn.next(token, length))
+      {
+         if (!parseCoordinate(token, length, numCol, numRow, from))
+         {
+            stopped[chunk] = BAD_TOKEN;
+            break;
+         }
+         if (!chunkIn.next(token, length))
+         {
+            stopped[chunk] = SPLIT_PAIR;
+            break;
+         }
+         if (!parseCoordinate(token, length, numCol, numRow, to))
+         {
+            stopped[chunk] = BAD_TOKEN;
+            break;
+         }
+         lists[chunk].push_back(from);
+         lists[chunk].push_back(to);
+      }
+   });
+
+   // like the serial reader, nothing after the first bad token counts.
+   // A chunk ending halfway through a pair has its last token paired
+   // with the next chunk's first, throwing every later chunk out of
+   // step, so such a file is read again the serial way.
+   int numLists = numChunks;
+   for (int chunk = 0; chunk < numChunks; chunk++)
+      if (stopped[chunk])
+      {
+         if (stopped[chunk] == SPLIT_PAIR && chunk + 1 < numChunks)
+            return readMaze <G> (fileName);
+         numLists = chunk + 1;
+         break;
+      }
+
+   G g(numCol * numRow, numCol);
+   mergeEdges(g, &lists[0], numLists, pool);
+   g.pack();
+   return g;
+}
+
+// the graphs a maze can be read into and drawn from
+template DenseGraph readMaze <DenseGraph> (const char* fileName);
+template CsrGraph   readMaze <CsrGraph>   (const char* fileName);
+template ListGraph  readMaze <ListGraph>  (const char* fileName);
+template GridGraph  readMaze <GridGraph>  (const char* fileName);
+template DenseGraph readMaze <DenseGraph> (const char* fileName, ThreadPool& pool);
+template CsrGraph   readMaze <CsrGraph>   (const char* fileName, ThreadPool& pool);
+template ListGraph  readMaze <ListGraph>  (const char* fileName, ThreadPool& pool);
+template GridGraph  readMaze <GridGraph>  (const char* fileName, ThreadPool& pool);
+template void drawMaze(const MappedGraph& g, const Vector<Vertex>& path);
+template void drawMaze(const DenseGraph& g, const Vector<Vertex>& path);
+template void drawMaze(const CsrGraph&   g, const Vector<Vertex>& path);
+template void drawMaze(const ListGraph&  g, const Vector<Vertex>& path);
+template void drawMaze(const GridGraph&  g, const Vector<Vertex>& path);
+template void drawMaze(const DeadEndView<DenseGraph>& g, const Vector<Vertex>& path);
+template void drawMaze(const DeadEndView<CsrGraph>&   g, const Vector<Vertex>& path);
+template void drawMaze(const DeadEndView<ListGraph>&  g, const Vector<Vertex>& path);
+template void drawMaze(const DeadEndView<GridGraph>&  g, const Vector<Vertex>& path);
+
+/*********************************************
+ * CONVERT MAZE
+ * Read a maze in the text format and save it in
+ * the binary graph format so loadMaze can map it
+ ********************************************/
+void convertMaze(const char* textFileName, const char* binaryFileName)
+{
+   CsrGraph g = readMaze <CsrGraph> (textFileName);
+   writeGraph(g, binaryFileName, g.getContext().maxCol);
+}
+
+/*********************************************
+ * LOAD MAZE
+ * Map a maze saved by convertMaze. Nothing is
+ * parsed: the graph is served from the mapping.
+ ********************************************/
+MappedGraph loadMaze(const char* binaryFileName)
+{
+   MappedGraph g(binaryFileName);
+   if (g.numColumns() <= 0 || g.size() % g.numColumns() != 0)
+      throw "ERROR: The graph file does not hold a maze.";
+   return g;
 }
 
 /******************************************
  * SOLVE MAZE
  * Read a maze from the file, display it,
- * then solve it
+ * then solve it. The dead ends are filled
+ * first, leaving little but the way through.
  *****************************************/
 void solveMaze()
 {
@@ -175,12 +392,17 @@ void solveMaze()
 	string fileName;
 	cin >> fileName;
 
+	// a maze that could not be read comes back without columns, and
+	// readMaze has already said why
 	Graph masa = readMaze(fileName.c_str());
-	CVertex start = CVertex(0, 0);
-	int gsize = masa.size();
-	CVertex end = CVertex(gsize, gsize);
+	if (masa.getContext().maxCol == 0)
+		return;
+
+	CVertex start(0, 0, masa.getContext());
+	CVertex end(start.getMaxCol() - 1, start.getMaxRow() - 1, masa.getContext());
 	Vector<Vertex> path;
-	path = masa.findPath(start, end);
+	DeadEndView<Graph> solution(masa, start, end);
+	path = solution.findPath(start, end);
 
 	drawMaze(masa, path);
 
@@ -12,15 +12,32 @@
 #define MAZE_H
 
 #include "graph.h"
+#include "graphfile.h"
 #include "vector.h"
+#include "threadpool.h"
 
 // solve the maze, the main program function
 void solveMaze();
 
-// read a maze in from a file
-Graph readMaze(const char* fileName);
+// read a maze in from a file. Any of the graphs in graph.h will do:
+//    CsrGraph g = readMaze <CsrGraph> ("maze.txt");
+template <class G = Graph>
+G readMaze(const char* fileName);
+
+// read a maze using every thread in the pool. The file is split into
+// chunks at line boundaries; a file with a pair broken across lines
+// gives the same graph, but is read on one thread.
+template <class G = Graph>
+G readMaze(const char* fileName, ThreadPool& pool);
+
+// convert a maze from the text format to the binary graph format
+void convertMaze(const char* textFileName, const char* binaryFileName);
+
+// map a maze saved by convertMaze, ready to query and draw
+MappedGraph loadMaze(const char* binaryFileName);
 
 // display a maze on the screen
-void drawMaze(const Graph& g, const Vector<Vertex>& path);
+template <class G>
+void drawMaze(const G& g, const Vector<Vertex>& path);
 
 #endif // MAZE_H
@@ -0,0 +1,173 @@
+/***********************************************************************
+ * Header:
+ *    MULTI SOURCE
+ * Summary:
+ *    Distances from many sources at once. A breadth-first search from
+ *    each source would walk the same edges again and again; instead up
+ *    to 64 searches share one sweep (MS-BFS). Every vertex keeps a word
+ *    with a bit per source: which searches have seen it, and which have
+ *    it on their frontier. Following an edge hands over all of the
+ *    frontier bits the neighbor has not seen yet with one AND and one
+ *    OR, so a single pass over the adjacency serves 64 queries.
+ *        DistanceMatrix  : the hops from every source to every target
+ *        findDistances() : fill one in
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef MULTISOURCE_H
+#define MULTISOURCE_H
+
+#include <vector>
+#include "graph.h"
+#include "bits.h"
+
+/*****************************************
+ * DISTANCE MATRIX
+ * One row per source and one column per target.
+ * A target that cannot be reached is -1 away.
+ ****************************************/
+class DistanceMatrix
+{
+public:
+	DistanceMatrix() : numSources(0), numTargets(0) {}
+	void resize(int numSources, int numTargets)
+	{
+		this->numSources = numSources;
+		this->numTargets = numTargets;
+		cells.assign((size_t)numSources * numTargets, -1);
+	}
+	int getNumSources() const { return numSources; }
+	int getNumTargets() const { return numTargets; }
+	int operator()(int source, int target) const
+	{
+		return cells[(size_t)source * numTargets + target];
+	}
+	int& operator()(int source, int target)
+	{
+		return cells[(size_t)source * numTargets + target];
+	}
+
+private:
+	int numSources;
+	int numTargets;
+	std::vector<int> cells;
+};
+
+/*********************************************
+ * FIND DISTANCES
+ * The BFS distance from every source to every
+ * target, 64 sources per sweep. A sweep stops as
+ * soon as each of its sources has found every
+ * target, or the frontier runs dry. Only the
+ * vertices on the frontier are visited each level,
+ * so long narrow mazes cost no more than wide ones.
+ ********************************************/
+template <class G>
+void findDistances(const G& g, const Vector<Vertex>& sources,
+                   const Vector<Vertex>& targets, DistanceMatrix& distances)
+	throw (const char*)
+{
+	g.pack();
+	int numV = g.size();
+	distances.resize(sources.size(), targets.size());
+
+	// where each target vertex sits among the targets, repeats chained
+	std::vector<int> firstTarget;
+	std::vector<int> nextTarget(targets.size(), -1);
+	std::vector<Word> seen;
+	std::vector<Word> visit;
+	std::vector<Word> visitNext;
+	std::vector<int> frontier;
+	std::vector<int> frontierNext;
+	try
+	{
+		firstTarget.assign(numV, -1);
+		seen.assign(numV, 0);
+		visit.assign(numV, 0);
+		visitNext.assign(numV, 0);
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the search.";
+	}
+	for (int t = targets.size() - 1; t >= 0; t--)
+	{
+		nextTarget[t] = firstTarget[targets[t].index()];
+		firstTarget[targets[t].index()] = t;
+	}
+
+	// every target a search has seen is one more distance found
+	int remaining;
+	auto record = [&](int v, Word bits, int first, int level)
+	{
+		for (int t = firstTarget[v]; t != -1; t = nextTarget[t])
+			for (Word b = bits; b; b &= b - 1)
+			{
+				distances(first + countTrailingZeros(b), t) = level;
+				remaining--;
+			}
+	};
+
+	for (int first = 0; first < sources.size(); first += WORD_BITS)
+	{
+		int batch = std::min(WORD_BITS, sources.size() - first);
+		remaining = batch * targets.size();
+		frontier.clear();
+
+		// level 0: each source sees itself
+		for (int i = 0; i < batch; i++)
+		{
+			int s = sources[first + i].index();
+			if (visit[s] == 0)
+				frontier.push_back(s);
+			seen[s] |= bitMask(i);
+			visit[s] |= bitMask(i);
+		}
+		for (size_t i = 0; i < frontier.size(); i++)
+			record(frontier[i], visit[frontier[i]], first, 0);
+
+		// hand the frontier bits across the edges a level at a time
+		for (int level = 1; !frontier.empty() && remaining > 0; level++)
+		{
+			frontierNext.clear();
+			for (size_t i = 0; i < frontier.size(); i++)
+			{
+				int v = frontier[i];
+				Word bits = visit[v];
+				g.forEachEdge(v, [&](int n)
+				{
+					Word fresh = bits & ~seen[n];
+					if (fresh)
+					{
+						if (visitNext[n] == 0)
+							frontierNext.push_back(n);
+						visitNext[n] |= fresh;
+						seen[n] |= fresh;
+					}
+				});
+			}
+			for (size_t i = 0; i < frontier.size(); i++)
+				visit[frontier[i]] = 0;
+			for (size_t i = 0; i < frontierNext.size(); i++)
+			{
+				int n = frontierNext[i];
+				visit[n] = visitNext[n];
+				visitNext[n] = 0;
+				if (firstTarget[n] != -1)
+					record(n, visit[n], first, level);
+			}
+			frontier.swap(frontierNext);
+		}
+
+		// ready the per-vertex words for the next batch
+		if (first + WORD_BITS < sources.size())
+		{
+			std::fill(seen.begin(), seen.end(), 0);
+			for (size_t i = 0; i < frontier.size(); i++)
+				visit[frontier[i]] = 0;
+		}
+	}
+}
+
+#endif // MULTISOURCE_H
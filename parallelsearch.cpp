@@ -0,0 +1,61 @@
+#include "parallelsearch.h"
+
+/*********************************************
+ * PARALLEL WORKSPACE :: BEGIN
+ * Forget the last search, growing the arrays
+ * only for a bigger graph than any seen before
+ ********************************************/
+void ParallelWorkspace::begin(int numVertices, int numThreads) throw (const char*)
+{
+	if (numVertices > capacity)
+	{
+		release();
+		try
+		{
+			stamps = new std::atomic<unsigned int>[numVertices];
+			parents = new int[numVertices];
+			distances = new int[numVertices];
+			current = new int[numVertices];
+			next = new int[numVertices];
+		}
+		catch (const std::bad_alloc)
+		{
+			release();
+			throw "ERROR: Unable to allocate memory for the search.";
+		}
+		capacity = numVertices;
+		generation = 0;
+	}
+
+	// stamp 0 never matches, so a fresh or wrapped workspace starts clean
+	if (++generation == 0 || generation == 1)
+	{
+		for (int i = 0; i < capacity; i++)
+			stamps[i].store(0, std::memory_order_relaxed);
+		generation = 1;
+	}
+
+	buffers.resize(numThreads);
+	for (int t = 0; t < numThreads; t++)
+		buffers[t].clear();
+	starts.assign(numThreads + 1, 0);
+}
+
+/*********************************************
+ * PARALLEL WORKSPACE :: RELEASE
+ * Free the per-vertex arrays
+ ********************************************/
+void ParallelWorkspace::release()
+{
+	delete[] stamps;
+	delete[] parents;
+	delete[] distances;
+	delete[] current;
+	delete[] next;
+	stamps = NULL;
+	parents = NULL;
+	distances = NULL;
+	current = NULL;
+	next = NULL;
+	capacity = 0;
+}
@@ -0,0 +1,169 @@
+/***********************************************************************
+ * Header:
+ *    PARALLEL SEARCH
+ * Summary:
+ *    A level-synchronous breadth-first search spread over a ThreadPool.
+ *    Each level of the frontier is cut into slices that the threads
+ *    expand at the same time. A vertex is claimed with a compare-and-
+ *    swap on its visited stamp, so exactly one thread records its
+ *    parent, and each thread collects the vertices it claimed in its
+ *    own buffer. The buffers are then joined into the next frontier.
+ *    Since a level finishes before the next one starts, distances are
+ *    exactly those of the serial search.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef PARALLELSEARCH_H
+#define PARALLELSEARCH_H
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "graph.h"
+#include "threadpool.h"
+
+/*****************************************
+ * PARALLEL WORKSPACE
+ * The scratch space of findPathParallel. Like
+ * SearchWorkspace it starts a new search by bumping
+ * a generation number, so reuse is O(1) and free of
+ * allocation once it has grown to fit.
+ ****************************************/
+class ParallelWorkspace
+{
+public:
+	ParallelWorkspace() : capacity(0), generation(0), stamps(NULL),
+		parents(NULL), distances(NULL), current(NULL), next(NULL) {}
+	~ParallelWorkspace() { release(); }
+
+	// start a new search over numVertices vertices with numThreads threads
+	void begin(int numVertices, int numThreads) throw (const char*);
+
+	// true for the one thread that gets to visit v
+	bool claim(int v)
+	{
+		unsigned int seen = stamps[v].load(std::memory_order_relaxed);
+		return seen != generation &&
+		       stamps[v].compare_exchange_strong(seen, generation,
+		                                         std::memory_order_relaxed);
+	}
+	bool isVisited(int v) const
+	{
+		return stamps[v].load(std::memory_order_relaxed) == generation;
+	}
+	int predecessor(int v) const { return parents[v]; }
+	int distance(int v) const { return distances[v]; }
+
+private:
+	ParallelWorkspace(const ParallelWorkspace& rhs);
+	ParallelWorkspace& operator=(const ParallelWorkspace& rhs);
+	void release();
+
+	int capacity;
+	unsigned int generation;
+	std::atomic<unsigned int>* stamps;
+	int* parents;                        // written only by the claimer
+	int* distances;
+	int* current;                        // this level of the frontier
+	int* next;                           // the level being built
+	std::vector< std::vector<int> > buffers;   // one per thread
+	std::vector<int> starts;             // where each buffer goes in next
+
+	template <class G>
+	friend bool findPathParallel(const G& g, const Vertex& v1, const Vertex& v2,
+	                             ThreadPool& pool, ParallelWorkspace& ws,
+	                             Vector<Vertex>& path);
+};
+
+/*********************************************
+ * FIND PATH PARALLEL
+ * Breadth-first search from v1 on the pool, one
+ * level at a time, stopping with the level that
+ * reaches v2. Levels smaller than a task are done
+ * on the calling thread alone. Fills in the
+ * vertices from v1 through v2, the same length as
+ * BasicGraph::findPath, or returns false with an
+ * empty path.
+ ********************************************/
+template <class G>
+bool findPathParallel(const G& g, const Vertex& v1, const Vertex& v2,
+                      ThreadPool& pool, ParallelWorkspace& ws,
+                      Vector<Vertex>& path)
+{
+	g.pack();   // the threads only ever read the graph
+	ws.begin(g.size(), pool.size());
+	path.clear();
+
+	int start = v1.index();
+	int goal = v2.index();
+	ws.claim(start);
+	ws.parents[start] = start;
+	ws.distances[start] = 0;
+	ws.current[0] = start;
+	int size = 1;
+	std::atomic<bool> found(start == goal);
+	int level = 0;
+
+	// expand one slice of the level into this thread's buffer
+	std::function<void (int, int)> expand = [&](int task, int thread)
+	{
+		std::vector<int>& buffer = ws.buffers[thread];
+		int end = std::min(size, (task + 1) * PARALLEL_GRAIN);
+		for (int i = task * PARALLEL_GRAIN; i < end; i++)
+		{
+			int v = ws.current[i];
+			g.forEachEdge(v, [&](int n)
+			{
+				if (ws.claim(n))
+				{
+					ws.parents[n] = v;
+					ws.distances[n] = level;
+					buffer.push_back(n);
+					if (n == goal)
+						found = true;
+				}
+			});
+			if (found.load(std::memory_order_relaxed))
+				return;
+		}
+	};
+
+	// copy one thread's buffer to its place in the next level
+	std::function<void (int, int)> join = [&](int t, int thread)
+	{
+		std::copy(ws.buffers[t].begin(), ws.buffers[t].end(),
+		          ws.next + ws.starts[t]);
+		ws.buffers[t].clear();
+	};
+
+	int numBuffers = (int)ws.buffers.size();
+	while (size > 0 && !found)
+	{
+		level++;
+		int numTasks = (size + PARALLEL_GRAIN - 1) / PARALLEL_GRAIN;
+		if (numTasks == 1)
+			expand(0, 0);
+		else
+			pool.run(numTasks, expand);
+
+		for (int t = 0; t < numBuffers; t++)
+			ws.starts[t + 1] = ws.starts[t] + (int)ws.buffers[t].size();
+		size = ws.starts[numBuffers];
+		if (size < PARALLEL_GRAIN)
+			for (int t = 0; t < numBuffers; t++)
+				join(t, 0);
+		else
+			pool.run(numBuffers, join);
+		std::swap(ws.current, ws.next);
+	}
+	if (!found)
+		return false;
+
+	buildPath(start, goal, [&](int v) { return ws.predecessor(v); },
+	          g.getContext(), path);
+	return true;
+}
+
+#endif // PARALLELSEARCH_H
@@ -0,0 +1,105 @@
+#include "pathcache.h"
+
+/*********************************************
+ * PATH CACHE :: COST
+ * Roughly what an entry takes: the path, the list
+ * node and the hash table node
+ ********************************************/
+size_t PathCache::cost(const Entry& entry)
+{
+	return sizeof(Entry) + entry.path.capacity() * sizeof(int) +
+	       4 * sizeof(void*) + sizeof(long long) + sizeof(Entries::iterator);
+}
+
+/*********************************************
+ * PATH CACHE :: FORGET IF STALE
+ * Entries from another graph, or from this one
+ * before its last change, are worthless
+ ********************************************/
+void PathCache::forgetIfStale(unsigned long long graph,
+                              unsigned long long edits)
+{
+	if (graph != this->graph || edits != this->edits)
+	{
+		clear();
+		this->graph = graph;
+		this->edits = edits;
+	}
+}
+
+/*********************************************
+ * PATH CACHE :: LOOKUP
+ * Find the pair and move it to the front
+ ********************************************/
+bool PathCache::lookup(unsigned long long graph, unsigned long long edits,
+                       int from, int to,
+                       const VertexContext& context, bool& found,
+                       Vector<Vertex>& path)
+{
+	forgetIfStale(graph, edits);
+	std::unordered_map<long long, Entries::iterator>::iterator it =
+		index.find(keyOf(from, to));
+	if (it == index.end())
+	{
+		misses++;
+		return false;
+	}
+	hits++;
+	entries.splice(entries.begin(), entries, it->second);
+
+	const std::vector<int>& stored = it->second->path;
+	path.clear();
+	for (size_t i = 0; i < stored.size(); i++)
+		path.push_back(Vertex(stored[i], context));
+	found = !stored.empty();
+	return true;
+}
+
+/*********************************************
+ * PATH CACHE :: STORE
+ * Put the pair at the front, then drop the least
+ * recently used entries until the budget is met.
+ * A path too big for the budget is not kept.
+ ********************************************/
+void PathCache::store(unsigned long long graph, unsigned long long edits,
+                      int from, int to, const Vector<Vertex>& path)
+{
+	forgetIfStale(graph, edits);
+	long long key = keyOf(from, to);
+	std::unordered_map<long long, Entries::iterator>::iterator it = index.find(key);
+	if (it != index.end())
+	{
+		used -= cost(*it->second);
+		entries.erase(it->second);
+		index.erase(it);
+	}
+
+	Entry entry;
+	entry.key = key;
+	entry.path.reserve(path.size());
+	for (int i = 0; i < path.size(); i++)
+		entry.path.push_back(path(i).index());
+	if (cost(entry) > budget)
+		return;
+
+	entries.push_front(entry);
+	index[key] = entries.begin();
+	used += cost(entries.front());
+	while (used > budget)
+	{
+		used -= cost(entries.back());
+		index.erase(entries.back().key);
+		entries.pop_back();
+	}
+}
+
+/*********************************************
+ * PATH CACHE :: CLEAR
+ * Forget every path; the counts are kept
+ ********************************************/
+void PathCache::clear()
+{
+	entries.clear();
+	index.clear();
+	used = 0;
+}
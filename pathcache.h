@@ -0,0 +1,103 @@
+/***********************************************************************
+ * Header:
+ *    PATH CACHE
+ * Summary:
+ *    Remembers solved paths so a query repeated against an unchanged
+ *    graph is answered without searching. Entries are keyed by the
+ *    (from, to) pair and tagged with the id and edit count of the graph
+ *    they were solved on; the first lookup against another graph, or
+ *    the same one after a change, empties the cache, so add() and
+ *    clear() invalidate it without any help. When
+ *    the paths take more than the byte budget, the least recently used
+ *    ones are dropped.
+ *        PathCache        : the cache itself, with hit and miss counts
+ *        findPathCached() : findPath through a cache
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include "graph.h"
+#include "search.h"
+
+/*****************************************
+ * PATH CACHE
+ * Paths are kept as vertex indices and handed
+ * back as vertices of the graph asking, so one
+ * cache must not be shared between graphs of
+ * different shapes. Not safe to use from two
+ * threads at once.
+ ****************************************/
+class PathCache
+{
+public:
+	PathCache(size_t budget = 1 << 20) : budget(budget), used(0),
+		graph(0), edits(0), hits(0), misses(0) {}
+
+	// a remembered answer: true if there was one, with found and path set
+	bool lookup(unsigned long long graph, unsigned long long edits,
+	            int from, int to, const VertexContext& context, bool& found,
+	            Vector<Vertex>& path);
+
+	// remember an answer; an empty path means to is unreachable
+	void store(unsigned long long graph, unsigned long long edits,
+	           int from, int to, const Vector<Vertex>& path);
+
+	void clear();
+	int size() const { return (int)entries.size(); }
+	size_t bytesUsed() const { return used; }
+	size_t getBudget() const { return budget; }
+	long long numHits() const { return hits; }
+	long long numMisses() const { return misses; }
+
+private:
+	struct Entry
+	{
+		long long key;
+		std::vector<int> path;
+	};
+	typedef std::list<Entry> Entries;
+
+	static long long keyOf(int from, int to)
+	{
+		return ((long long)from << 32) | (unsigned int)to;
+	}
+	static size_t cost(const Entry& entry);
+	void forgetIfStale(unsigned long long graph, unsigned long long edits);
+
+	size_t budget;
+	size_t used;
+	unsigned long long graph;     // the id of the graph every entry was
+	unsigned long long edits;     // solved on, and its edits by then
+	Entries entries;              // the most recently used first
+	std::unordered_map<long long, Entries::iterator> index;
+	long long hits;
+	long long misses;
+};
+
+/*********************************************
+ * FIND PATH CACHED
+ * BasicGraph::findPath, answered from the cache
+ * when the same pair was solved on this graph
+ * since its last change
+ ********************************************/
+template <class G>
+bool findPathCached(const G& g, const Vertex& v1, const Vertex& v2,
+                    PathCache& cache, SearchWorkspace& ws, Vector<Vertex>& path)
+	throw (const char*)
+{
+	bool found;
+	if (cache.lookup(g.getId(), g.getEdits(), v1.index(), v2.index(),
+	                 g.getContext(), found, path))
+		return found;
+	found = g.findPath(v1, v2, ws, path);
+	cache.store(g.getId(), g.getEdits(), v1.index(), v2.index(), path);
+	return found;
+}
+
+#endif // PATHCACHE_H
@@ -0,0 +1,115 @@
+#include <new>
+#include "scanner.h"
+
+/*********************************************
+ * SCANNER :: OPEN
+ * Start scanning a file. False if it cannot be
+ * opened.
+ ********************************************/
+bool Scanner::open(const char* fileName)
+{
+   close();
+   fp = fopen(fileName, "rb");
+   return fp != NULL;
+}
+
+/*********************************************
+ * SCANNER :: OPEN
+ * Scan the text in [begin, end) in place
+ ********************************************/
+void Scanner::open(const char* begin, const char* end)
+{
+   close();
+   pos = begin;
+   this->end = end;
+}
+
+/*********************************************
+ * SCANNER :: CLOSE
+ ********************************************/
+void Scanner::close()
+{
+   if (fp)
+      fclose(fp);
+   delete [] buffer;
+   fp = NULL;
+   buffer = NULL;
+   capacity = 0;
+   pos = end = NULL;
+}
+
+/*********************************************
+ * SCANNER :: REFILL
+ * Slide whatever has not been scanned yet to the
+ * front of the buffer and read the next block in
+ * behind it. The buffer only grows if a single
+ * token is longer than the whole buffer.
+ ********************************************/
+bool Scanner::refill() throw (const char*)
+{
+   if (fp == NULL)
+      return false;
+
+   size_t unread = end - pos;
+   if (unread == capacity)
+   {
+      size_t newCapacity = capacity ? capacity * 2 : SCANNER_BLOCK;
+      char* pNew;
+      try
+      {
+         pNew = new char[newCapacity];
+      }
+      catch (const std::bad_alloc &)
+      {
+         throw "ERROR: Unable to allocate a buffer for the scanner";
+      }
+      for (size_t i = 0; i < unread; i++)
+         pNew[i] = pos[i];
+      delete [] buffer;
+      buffer = pNew;
+      capacity = newCapacity;
+   }
+   else
+   {
+      for (size_t i = 0; i < unread; i++)
+         buffer[i] = pos[i];
+   }
+
+   size_t numRead = fread(buffer + unread, 1, capacity - unread, fp);
+   pos = buffer;
+   end = buffer + unread + numRead;
+   return numRead > 0;
+}
+
+/*********************************************
+ * SCANNER :: NEXT
+ * Skip the whitespace and return the next token
+ ********************************************/
+bool Scanner::next(const char*& token, int& length) throw (const char*)
+{
+   // skip to the start of the token
+   for (;;)
+   {
+      while (pos < end && isSpace(*pos))
+         pos++;
+      if (pos < end)
+         break;
+      if (!refill())
+         return false;
+   }
+
+   // find the end of it, reading more if it runs off the buffer
+   size_t len = 0;
+   for (;;)
+   {
+      while (pos + len < end && !isSpace(pos[len]))
+         len++;
+      if (pos + len < end || !refill())
+         break;
+   }
+
+   token = pos;
+   length = (int)len;
+   pos += len;
+   return true;
+}
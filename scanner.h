@@ -0,0 +1,111 @@
+/***********************************************************************
+ * Header:
+ *    SCANNER
+ * Summary:
+ *    A streaming tokenizer for the maze and course files. It reads the
+ *    file in large blocks and hands back whitespace-separated tokens as
+ *    pointers into its buffer, so nothing is allocated per token and no
+ *    locale-aware stream machinery is involved. It can also scan text
+ *    that is already in memory, such as one chunk of a mapped file.
+ *
+ *        Scanner          : splits a file into tokens
+ *        parseInt()       : "25"  --> 25
+ *        parseCoordinate(): "j10" --> the index of column 9, row 9
+ *                           "ab7" --> the index of column 27, row 6
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <cstdio>
+#include <cstddef>
+#include <climits>
+#include "vertex.h"   // for parseCell()
+
+#ifndef SCANNER_BLOCK
+#define SCANNER_BLOCK (1 << 20)   // bytes read from the file at a time
+#endif
+
+/*****************************************
+ * SCANNER
+ * A token is only valid until the next call
+ * to next(), since the buffer gets reused.
+ ****************************************/
+class Scanner
+{
+public:
+   Scanner() : fp(NULL), buffer(NULL), capacity(0), pos(NULL), end(NULL) {}
+   ~Scanner() { close(); }
+
+   bool open(const char* fileName);
+   void open(const char* begin, const char* end);   // text already in memory
+   void close();
+
+   // fetch the next token, false at the end of the file
+   bool next(const char*& token, int& length) throw (const char*);
+
+   // the next unread character
+   const char* position() const { return pos; }
+
+private:
+   Scanner(const Scanner& rhs);
+   Scanner& operator = (const Scanner& rhs);
+
+   bool refill() throw (const char*);
+
+   FILE* fp;
+   char* buffer;
+   size_t capacity;
+   const char* pos;   // the next unread character
+   const char* end;   // one past the last character read so far
+};
+
+/**********************************************
+ * IS SPACE
+ * The characters that separate tokens
+ **********************************************/
+inline bool isSpace(char c)
+{
+   return c == ' ' || c == '\n' || c == '\r' || c == '\t' ||
+          c == '\f' || c == '\v';
+}
+
+/**********************************************
+ * PARSE INT
+ * A non-negative decimal number
+ **********************************************/
+inline bool parseInt(const char* s, int length, int& value)
+{
+   if (length == 0)
+      return false;
+   value = 0;
+   for (int i = 0; i < length; i++)
+   {
+      if (s[i] < '0' || s[i] > '9' || value > (INT_MAX - 9) / 10)
+         return false;
+      value = value * 10 + (s[i] - '0');
+   }
+   return true;
+}
+
+/**********************************************
+ * PARSE COORDINATE
+ * A maze cell such as "b4" or "ab120": the
+ * column is spreadsheet-style letters and the row
+ * a 1-based number. Sets the CVertex-style index
+ * row * numCol + col.
+ **********************************************/
+inline bool parseCoordinate(const char* s, int length,
+                            int numCol, int numRow, int& index)
+{
+   int col;
+   int row;
+   if (!parseCell(s, length, col, row) || col >= numCol || row >= numRow)
+      return false;
+   index = row * numCol + col;
+   return true;
+}
+
+#endif // SCANNER_H
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include "scc.h"
+
+/*********************************************
+ * STRONG COMPONENTS :: BUILD
+ * Tarjan's algorithm. Each vertex is numbered
+ * in the order it is reached and remembers the
+ * lowest number it can get back to; a vertex
+ * that cannot get back above itself is the root
+ * of a component made of everything pushed
+ * since it. The call stack holds each vertex
+ * being explored with the next edge it has to
+ * try. Components come off in reverse
+ * topological order, so they are numbered down.
+ ********************************************/
+void StrongComponents::build(std::vector<int>& offsets, std::vector<int>& targets)
+	throw (const char*)
+{
+	int numV = (int)offsets.size() - 1;
+	componentOf.assign(numV, -1);
+	selfLoops.assign(numV, 0);
+	std::vector<int> order(numV, -1);   // when reached, -1 if not yet
+	std::vector<int> low(numV);
+	std::vector<int> stack;             // reached, not yet in a component
+	std::vector<int> callVertex;
+	std::vector<int> callEdge;
+	stack.reserve(numV);
+	int counter = 0;
+	int next = numV;                    // numbered down from the top
+
+	for (int root = 0; root < numV; root++)
+	{
+		if (order[root] != -1)
+			continue;
+		order[root] = low[root] = counter++;
+		stack.push_back(root);
+		callVertex.push_back(root);
+		callEdge.push_back(offsets[root]);
+
+		while (!callVertex.empty())
+		{
+			int v = callVertex.back();
+			int& edge = callEdge.back();
+			if (edge < offsets[v + 1])
+			{
+				int n = targets[edge++];
+				if (n == v)
+					selfLoops[v] = 1;
+				if (order[n] == -1)
+				{
+					order[n] = low[n] = counter++;
+					stack.push_back(n);
+					callVertex.push_back(n);
+					callEdge.push_back(offsets[n]);
+				}
+				else if (componentOf[n] == -1)
+					low[v] = std::min(low[v], order[n]);
+				continue;
+			}
+
+			// v is done: close its component, or pass its low up
+			callVertex.pop_back();
+			callEdge.pop_back();
+			if (low[v] == order[v])
+			{
+				next--;
+				int member;
+				do
+				{
+					member = stack.back();
+					stack.pop_back();
+					componentOf[member] = next;
+				}
+				while (member != v);
+			}
+			if (!callVertex.empty())
+			{
+				int parent = callVertex.back();
+				low[parent] = std::min(low[parent], low[v]);
+			}
+		}
+	}
+
+	// shift the numbers down to start at 0
+	int numC = numV - next;
+	for (int v = 0; v < numV; v++)
+		componentOf[v] -= next;
+
+	// the members of each component, by counting sort
+	memberOffsets.assign(numC + 1, 0);
+	for (int v = 0; v < numV; v++)
+		memberOffsets[componentOf[v] + 1]++;
+	for (int c = 0; c < numC; c++)
+		memberOffsets[c + 1] += memberOffsets[c];
+	memberVertices.resize(numV);
+	std::vector<int>& fill = low;
+	std::copy(memberOffsets.begin(), memberOffsets.end() - 1, fill.begin());
+	for (int v = 0; v < numV; v++)
+		memberVertices[fill[componentOf[v]]++] = v;
+	for (int v = 0; v < numV; v++)
+		if (isCyclic(v))
+			numCyclic++;
+
+	// the condensation, each edge between components once
+	condensed = CsrGraph(numC);
+	std::vector<int>& seen = order;
+	std::fill(seen.begin(), seen.end(), -1);
+	for (int c = 0; c < numC; c++)
+		for (int i = memberOffsets[c]; i < memberOffsets[c + 1]; i++)
+		{
+			int v = memberVertices[i];
+			for (int e = offsets[v]; e < offsets[v + 1]; e++)
+			{
+				int d = componentOf[targets[e]];
+				if (d != c && seen[d] != c)
+				{
+					seen[d] = c;
+					condensed.addEdge(c, d);
+				}
+			}
+		}
+	condensed.pack();
+}
@@ -0,0 +1,99 @@
+/***********************************************************************
+ * Header:
+ *    SCC
+ * Summary:
+ *    The strongly connected components of a directed graph: the
+ *    largest groups of vertices that can each reach all the others.
+ *    Any cycle lies inside one, so a prerequisite graph is sound only
+ *    when every component is a single class that does not require
+ *    itself. Squeezing each component down to one vertex leaves the
+ *    condensation, a graph with no cycles at all.
+ *
+ *    Tarjan's algorithm finds them in one depth-first pass, kept on
+ *    explicit stacks rather than the call stack so a path millions of
+ *    vertices deep cannot overflow it.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef SCC_H
+#define SCC_H
+
+#include <vector>
+#include "graph.h"
+
+/*****************************************
+ * STRONG COMPONENTS
+ * Worked out once from a copy of the edges, so
+ * it sees nothing added to the graph afterwards.
+ * Components are numbered in topological order:
+ * every edge of the condensation runs from a
+ * lower number to a higher one.
+ ****************************************/
+class StrongComponents
+{
+public:
+	template <class G>
+	StrongComponents(const G& g) throw (const char*);
+
+	int numVertices() const { return (int)componentOf.size(); }
+	int numComponents() const { return (int)memberOffsets.size() - 1; }
+
+	// the component holding v
+	int component(int v) const { return componentOf[v]; }
+	int component(const Vertex& v) const { return componentOf[v.index()]; }
+
+	// the vertices of a component, size(c) of them
+	int size(int c) const { return memberOffsets[c + 1] - memberOffsets[c]; }
+	const int* members(int c) const { return &memberVertices[memberOffsets[c]]; }
+
+	// is v on a cycle: in a bigger component, or with an edge to itself
+	bool isCyclic(int v) const
+	{
+		return size(componentOf[v]) > 1 || selfLoops[v];
+	}
+	bool hasCycle() const { return numCyclic > 0; }
+
+	// one vertex per component, with an edge wherever the graph has one
+	// between two of them, given once
+	const CsrGraph& condensation() const { return condensed; }
+
+private:
+	void build(std::vector<int>& offsets, std::vector<int>& targets)
+		throw (const char*);
+
+	std::vector<int> componentOf;
+	std::vector<int> memberOffsets;
+	std::vector<int> memberVertices;
+	std::vector<char> selfLoops;
+	int numCyclic;
+	CsrGraph condensed;
+};
+
+/*********************************************
+ * STRONG COMPONENTS : CONSTRUCTOR
+ * Copy the edges of g into compressed rows,
+ * counting them on a first pass so nothing has
+ * to grow, then find the components
+ ********************************************/
+template <class G>
+StrongComponents::StrongComponents(const G& g) throw (const char*)
+	: numCyclic(0), condensed(0)
+{
+	g.pack();
+	int numV = g.size();
+	std::vector<int> offsets(numV + 1, 0);
+	for (int v = 0; v < numV; v++)
+		g.forEachEdge(v, [&](int n) { offsets[v + 1]++; });
+	for (int v = 0; v < numV; v++)
+		offsets[v + 1] += offsets[v];
+	std::vector<int> targets(offsets[numV]);
+	for (int v = 0; v < numV; v++)
+	{
+		int fill = offsets[v];
+		g.forEachEdge(v, [&](int n) { targets[fill++] = n; });
+	}
+	build(offsets, targets);
+}
+
+#endif // SCC_H
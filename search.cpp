@@ -0,0 +1,75 @@
+#include "search.h"
+
+/*********************************************
+ * SEARCH WORKSPACE : CONSTRUCTOR
+ * Allocate up front for a graph of numVertices
+ ********************************************/
+SearchWorkspace::SearchWorkspace(int numVertices) throw (const char*)
+	: capacity(0), generation(0), stamps(NULL), parents(NULL),
+	  distances(NULL), queue(NULL), expanded(0)
+{
+	begin(numVertices);
+}
+
+SearchWorkspace::~SearchWorkspace()
+{
+	delete[] stamps;
+	delete[] parents;
+	delete[] distances;
+	delete[] queue;
+}
+
+/*********************************************
+ * SEARCH WORKSPACE :: BEGIN
+ * Forget the last search. The arrays are only
+ * reallocated when the graph is bigger than any
+ * seen before, and the stamps only cleared when
+ * the generation number wraps around.
+ ********************************************/
+void SearchWorkspace::begin(int numVertices) throw (const char*)
+{
+	if (numVertices > capacity)
+	{
+		unsigned int* newStamps = NULL;
+		int* newParents = NULL;
+		int* newDistances = NULL;
+		int* newQueue = NULL;
+		try
+		{
+			newStamps = new unsigned int[numVertices];
+			newParents = new int[numVertices];
+			newDistances = new int[numVertices];
+			newQueue = new int[numVertices];
+		}
+		catch (const std::bad_alloc)
+		{
+			delete[] newStamps;
+			delete[] newParents;
+			delete[] newDistances;
+			throw "ERROR: Unable to allocate memory for the search.";
+		}
+		delete[] stamps;
+		delete[] parents;
+		delete[] distances;
+		delete[] queue;
+		stamps = newStamps;
+		parents = newParents;
+		distances = newDistances;
+		queue = newQueue;
+		capacity = numVertices;
+		generation = 0;
+	}
+
+	// generations are even, leaving the low bit for closed. Stamp 0
+	// never matches, so a fresh or wrapped workspace starts clean.
+	generation += 2;
+	if (generation == 0 || generation == 2)
+	{
+		for (int i = 0; i < capacity; i++)
+			stamps[i] = 0;
+		generation = 2;
+	}
+	open.clear();
+	buckets.clear();
+	expanded = 0;
+}
@@ -0,0 +1,117 @@
+/***********************************************************************
+ * Header:
+ *    SEARCH
+ * Summary:
+ *    Scratch space for graph searches that is allocated once and reused
+ *    across queries. Instead of clearing its arrays, a new search bumps
+ *    a generation number: a vertex has been visited in this search only
+ *    if its stamp matches the current generation, and the low bit of
+ *    the stamp marks it expanded. Starting a search is therefore O(1)
+ *    and repeated queries do no heap allocation. The
+ *    workspace also carries the priority queues of the informed searches.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <new>
+#include <cstddef>
+#include "heap.h"
+#include "vertex.h"
+#include "vector.h"
+
+/*****************************************
+ * SEARCH WORKSPACE
+ * Per-vertex predecessor, distance and visited
+ * stamp, plus a queue with room for every vertex.
+ * One search at a time: give each thread its own.
+ ****************************************/
+class SearchWorkspace
+{
+public:
+	SearchWorkspace() : capacity(0), generation(0), stamps(NULL),
+		parents(NULL), distances(NULL), queue(NULL), expanded(0) {}
+	SearchWorkspace(int numVertices) throw (const char*);
+	~SearchWorkspace();
+
+	// start a new search over numVertices vertices
+	void begin(int numVertices) throw (const char*);
+
+	bool isVisited(int v) const { return (stamps[v] & ~1u) == generation; }
+	void visit(int v, int parent, int distance)
+	{
+		stamps[v] = generation;
+		parents[v] = parent;
+		distances[v] = distance;
+	}
+
+	// expanded, for the searches that need to know; visiting reopens
+	void close(int v) { stamps[v] = generation | 1; }
+	bool isClosed(int v) const { return stamps[v] == (generation | 1); }
+	int predecessor(int v) const { return parents[v]; }
+	int distance(int v) const { return distances[v]; }
+
+	// room for every vertex, for a queue or a stack
+	int* frontier() { return queue; }
+
+	// the open list of the informed searches
+	DaryHeap<4>& heap() { return open; }
+	RadixHeap& radixHeap() { return buckets; }
+
+	// add the path the parents lead from start to end onto path
+	void buildPath(int start, int end, const VertexContext& context,
+	               Vector<Vertex>& path) const;
+
+	// how many vertices the current search has expanded
+	void expand() { ++expanded; }
+	long long numExpanded() const { return expanded; }
+
+private:
+	SearchWorkspace(const SearchWorkspace& rhs);
+	SearchWorkspace& operator=(const SearchWorkspace& rhs);
+
+	int capacity;
+	unsigned int generation;
+	unsigned int* stamps;   // generation when visited, + 1 once closed
+	int* parents;
+	int* distances;
+	int* queue;
+	DaryHeap<4> open;
+	RadixHeap buckets;
+	long long expanded;
+};
+
+/*********************************************
+ * BUILD PATH
+ * Add the vertices from start through end onto
+ * the back of path. parent(v) gives the vertex
+ * before v, so the way is walked back from end
+ * and the part added is then turned around;
+ * whatever the path held before stays in front.
+ ********************************************/
+template <class Parent>
+void buildPath(int start, int end, Parent parent, const VertexContext& context,
+               Vector<Vertex>& path)
+{
+	int first = path.size();
+	for (int v = end; v != start; v = parent(v))
+		path.push_back(Vertex(v, context));
+	path.push_back(Vertex(start, context));
+	for (int i = first, j = path.size() - 1; i < j; ++i, --j)
+	{
+		Vertex tmp = path[i];
+		path[i] = path[j];
+		path[j] = tmp;
+	}
+}
+
+inline void SearchWorkspace::buildPath(int start, int end,
+                                       const VertexContext& context,
+                                       Vector<Vertex>& path) const
+{
+	::buildPath(start, end, [this](int v) { return parents[v]; }, context, path);
+}
+
+#endif // SEARCH_H
@@ -0,0 +1,657 @@
+#include <atomic>
+#include "storage.h"
+
+/*********************************************
+ * NEW WEIGHTS
+ * An array of costs, all starting at 1
+ ********************************************/
+static Weight* newWeights(size_t size) throw (const char*)
+{
+	Weight* weights;
+	try
+	{
+		weights = new Weight[size + 1];
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the edge costs.";
+	}
+	for (size_t i = 0; i < size; ++i)
+		weights[i] = 1;
+	return weights;
+}
+
+/******************************************************************
+ * DENSE STORAGE
+ ******************************************************************/
+
+void DenseStorage::init(int numNodes, int numCol) throw (const char*)
+{
+	Word* pNew;
+	try
+	{
+		pNew = new Word[(size_t)numNodes * numWords(numNodes)];
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+	delete[] matrix;
+	matrix = pNew;
+	numV = numNodes;
+	rowWords = numWords(numNodes);
+	clear();
+}
+
+DenseStorage::DenseStorage(const DenseStorage & rhs) throw (const char*)
+	: matrix(NULL), numV(0), rowWords(0)
+{
+	*this = rhs;
+}
+
+DenseStorage& DenseStorage::operator=(const DenseStorage & rhs) throw (const char*)
+{
+	if (&rhs == this)
+		return *this;
+	init(rhs.numV);
+	for (size_t i = 0; i < numMatrixWords(); ++i)
+		matrix[i] = rhs.matrix[i];
+	costs = rhs.costs;
+	return *this;
+}
+
+void DenseStorage::clear()
+{
+	for (size_t i = 0; i < numMatrixWords(); ++i)
+		matrix[i] = 0;
+	std::vector<CostRow>().swap(costs);
+}
+
+/*********************************************
+ * DENSE STORAGE :: ADD EDGE (weighted)
+ * The first edge that does not cost 1 makes the
+ * rows of costs, all empty since every edge so
+ * far costs 1
+ ********************************************/
+void DenseStorage::addEdge(int v1, int v2, Weight w) throw (const char*)
+{
+	if (costs.empty() && w != 1)
+	{
+		try
+		{
+			costs.resize(numV);
+		}
+		catch (const std::bad_alloc&)
+		{
+			throw "ERROR: Unable to allocate memory for the edge costs.";
+		}
+	}
+	addEdge(v1, v2);
+	if (!costs.empty())
+		setCost(v1, v2, w);
+}
+
+/*********************************************
+ * DENSE STORAGE :: SET COST
+ * Keep the row sorted, holding only the edges
+ * that cost something other than 1
+ ********************************************/
+void DenseStorage::setCost(int v1, int v2, Weight w)
+{
+	CostRow& r = costs[v1];
+	CostRow::iterator it = std::lower_bound(r.begin(), r.end(), Cost(v2, 0));
+	bool found = it != r.end() && it->first == v2;
+	if (w == 1)
+	{
+		if (found)
+			r.erase(it);
+	}
+	else if (found)
+		it->second = w;
+	else
+		r.insert(it, Cost(v2, w));
+}
+
+/******************************************************************
+ * CSR STORAGE
+ ******************************************************************/
+
+void CsrStorage::init(int numNodes, int numCol) throw (const char*)
+{
+	int* pNew;
+	try
+	{
+		pNew = new int[numNodes + 1];
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+	delete[] offsets;
+	delete[] neighbors;
+	offsets = pNew;
+	neighbors = NULL;
+	numV = numNodes;
+	clear();
+}
+
+CsrStorage::CsrStorage(const CsrStorage & rhs) throw (const char*)
+	: numV(0), offsets(NULL), neighbors(NULL), weights(NULL)
+{
+	*this = rhs;
+}
+
+CsrStorage& CsrStorage::operator=(const CsrStorage & rhs) throw (const char*)
+{
+	if (&rhs == this)
+		return *this;
+	rhs.pack();
+	init(rhs.numV);
+	try
+	{
+		neighbors = new int[rhs.offsets[rhs.numV] + 1];
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+	for (int i = 0; i <= numV; ++i)
+		offsets[i] = rhs.offsets[i];
+	for (int i = 0; i < offsets[numV]; ++i)
+		neighbors[i] = rhs.neighbors[i];
+	if (rhs.weights)
+	{
+		weights = newWeights(offsets[numV]);
+		for (int i = 0; i < offsets[numV]; ++i)
+			weights[i] = rhs.weights[i];
+	}
+	return *this;
+}
+
+void CsrStorage::clear()
+{
+	for (int i = 0; i <= numV; ++i)
+		offsets[i] = 0;
+	releasePending();
+	delete[] weights;
+	weights = NULL;
+}
+
+/*********************************************
+ * CSR STORAGE :: ADD EDGE (weighted)
+ * The first edge that does not cost 1 gives every
+ * edge so far, packed or pending, a cost of 1
+ ********************************************/
+void CsrStorage::addEdge(int v1, int v2, Weight w) throw (const char*)
+{
+	if (!weights && w != 1)
+	{
+		weights = newWeights(offsets[numV]);
+		pendingWeights.clear();
+		for (int i = 0; i < pending.size() / 2; ++i)
+			pendingWeights.push_back(1);
+	}
+	pending.push_back(v1);
+	pending.push_back(v2);
+	if (weights)
+		pendingWeights.push_back(w);
+}
+
+/*********************************************
+ * CSR STORAGE :: PACK
+ * Fold the buffered edges into the offsets and
+ * neighbors arrays: count the degree of every row,
+ * prefix-sum the counts into offsets, scatter the
+ * edges into place, then sort and de-duplicate
+ * each row so hasEdge can binary search it.
+ ********************************************/
+void CsrStorage::pack() const
+{
+	if (pending.empty())
+		return;
+
+	int numPending = pending.size() / 2;
+	int* newOffsets = NULL;
+	int* newNeighbors = NULL;
+	Weight* newWeights = NULL;
+	int* fill;
+	try
+	{
+		newOffsets = new int[numV + 1];
+		newNeighbors = new int[offsets[numV] + numPending];
+		if (weights)
+			newWeights = new Weight[offsets[numV] + numPending + 1];
+		fill = new int[numV];
+	}
+	catch (const std::bad_alloc&)
+	{
+		delete[] newOffsets;
+		delete[] newNeighbors;
+		delete[] newWeights;
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+
+	// count the degree of every row, old edges and new
+	for (int v = 0; v < numV; ++v)
+		newOffsets[v + 1] = offsets[v + 1] - offsets[v];
+	newOffsets[0] = 0;
+	for (int i = 0; i < numPending; ++i)
+		newOffsets[pending[2 * i] + 1]++;
+	for (int v = 0; v < numV; ++v)
+		newOffsets[v + 1] += newOffsets[v];
+
+	// scatter the edges into their rows
+	for (int v = 0; v < numV; ++v)
+	{
+		fill[v] = newOffsets[v];
+		for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+		{
+			if (weights)
+				newWeights[fill[v]] = weights[i];
+			newNeighbors[fill[v]++] = neighbors[i];
+		}
+	}
+	for (int i = 0; i < numPending; ++i)
+	{
+		if (weights)
+			newWeights[fill[pending[2 * i]]] = pendingWeights[i];
+		newNeighbors[fill[pending[2 * i]]++] = pending[2 * i + 1];
+	}
+	delete[] fill;
+
+	if (weights)
+	{
+		packWeighted(newOffsets, newNeighbors, newWeights);
+		delete[] weights;
+		weights = newWeights;
+		return;
+	}
+
+	// sort each row and squeeze out the duplicates
+	int write = 0;
+	for (int v = 0; v < numV; ++v)
+	{
+		int begin = newOffsets[v];
+		int end = newOffsets[v + 1];
+		std::sort(newNeighbors + begin, newNeighbors + end);
+		newOffsets[v] = write;
+		for (int i = begin; i < end; ++i)
+			if (i == begin || newNeighbors[i] != newNeighbors[i - 1])
+				newNeighbors[write++] = newNeighbors[i];
+	}
+	newOffsets[numV] = write;
+
+	delete[] offsets;
+	delete[] neighbors;
+	offsets = newOffsets;
+	neighbors = newNeighbors;
+	releasePending();
+}
+
+/*********************************************
+ * CSR STORAGE :: RELEASE PENDING
+ * Hand the buffers back once their edges are in
+ * the rows. Clearing alone would keep room for
+ * every edge ever added, twice over, for the life
+ * of the graph.
+ ********************************************/
+void CsrStorage::releasePending() const
+{
+	Vector<int>().swap(pending);
+	Vector<Weight>().swap(pendingWeights);
+}
+
+/*********************************************
+ * CSR STORAGE :: PACK WEIGHTED
+ * The last step of pack() when edges have costs.
+ * A row holds its old edges then its new ones in
+ * the order they were added, so sorting on the
+ * neighbor with the position as the tie breaker
+ * and keeping the last of each run lets the
+ * latest cost of an edge win.
+ ********************************************/
+void CsrStorage::packWeighted(int* newOffsets, int* newNeighbors,
+                              Weight* newWeights) const
+{
+	std::vector<long long> order;
+	std::vector<Weight> costs;
+	int write = 0;
+	for (int v = 0; v < numV; ++v)
+	{
+		int begin = newOffsets[v];
+		int end = newOffsets[v + 1];
+		order.clear();
+		costs.assign(newWeights + begin, newWeights + end);
+		for (int i = begin; i < end; ++i)
+			order.push_back(((long long)newNeighbors[i] << 32) | (i - begin));
+		std::sort(order.begin(), order.end());
+
+		newOffsets[v] = write;
+		for (size_t k = 0; k < order.size(); ++k)
+			if (k + 1 == order.size() || (order[k] >> 32) != (order[k + 1] >> 32))
+			{
+				newNeighbors[write] = (int)(order[k] >> 32);
+				newWeights[write++] = costs[order[k] & 0xFFFFFFFF];
+			}
+	}
+	newOffsets[numV] = write;
+
+	delete[] offsets;
+	delete[] neighbors;
+	offsets = newOffsets;
+	neighbors = newNeighbors;
+	releasePending();
+}
+
+/*********************************************
+ * CSR STORAGE :: ASSIGN
+ * The same counting sort as pack(), spread over
+ * the pool: count the degrees with atomic adds,
+ * prefix-sum them, scatter the edges through
+ * atomic row cursors, then sort and de-duplicate
+ * the rows a range at a time. The order the
+ * threads scatter in does not matter since every
+ * row is sorted afterward.
+ ********************************************/
+void CsrStorage::assign(const std::vector<int>* lists, int numLists,
+                        ThreadPool& pool) throw (const char*)
+{
+	int numRanges = pool.size() * 4;
+	std::atomic<int>* cursor = NULL;
+	int* start = NULL;
+	int* unique = NULL;
+	try
+	{
+		cursor = new std::atomic<int>[numV];
+		start = new int[numV + 1];
+		unique = new int[numV + 1];
+	}
+	catch (const std::bad_alloc&)
+	{
+		delete[] cursor;
+		delete[] start;
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+
+	// count the degree of every row
+	for (int v = 0; v < numV; ++v)
+		cursor[v].store(0, std::memory_order_relaxed);
+	pool.run(numLists, [&](int list, int thread)
+	{
+		const std::vector<int>& pairs = lists[list];
+		for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+			cursor[pairs[i]].fetch_add(1, std::memory_order_relaxed);
+	});
+	start[0] = 0;
+	for (int v = 0; v < numV; ++v)
+	{
+		start[v + 1] = start[v] + cursor[v].load(std::memory_order_relaxed);
+		cursor[v].store(start[v], std::memory_order_relaxed);
+	}
+
+	// scatter the edges into their rows
+	int* scratch;
+	try
+	{
+		scratch = new int[start[numV] + 1];
+	}
+	catch (const std::bad_alloc&)
+	{
+		delete[] cursor;
+		delete[] start;
+		delete[] unique;
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+	pool.run(numLists, [&](int list, int thread)
+	{
+		const std::vector<int>& pairs = lists[list];
+		for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+			scratch[cursor[pairs[i]].fetch_add(1, std::memory_order_relaxed)] = pairs[i + 1];
+	});
+	delete[] cursor;
+
+	// sort each row and count what is left once the duplicates go
+	pool.run(numRanges, [&](int range, int thread)
+	{
+		int first = (int)((long long)numV * range / numRanges);
+		int last = (int)((long long)numV * (range + 1) / numRanges);
+		for (int v = first; v < last; ++v)
+		{
+			std::sort(scratch + start[v], scratch + start[v + 1]);
+			unique[v + 1] = 0;
+			for (int i = start[v]; i < start[v + 1]; ++i)
+				if (i == start[v] || scratch[i] != scratch[i - 1])
+					unique[v + 1]++;
+		}
+	});
+	unique[0] = 0;
+	for (int v = 0; v < numV; ++v)
+		unique[v + 1] += unique[v];
+
+	// squeeze the rows together into the final arrays
+	int* newNeighbors;
+	try
+	{
+		newNeighbors = new int[unique[numV] + 1];
+	}
+	catch (const std::bad_alloc&)
+	{
+		delete[] scratch;
+		delete[] start;
+		delete[] unique;
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+	pool.run(numRanges, [&](int range, int thread)
+	{
+		int first = (int)((long long)numV * range / numRanges);
+		int last = (int)((long long)numV * (range + 1) / numRanges);
+		for (int v = first; v < last; ++v)
+		{
+			int write = unique[v];
+			for (int i = start[v]; i < start[v + 1]; ++i)
+				if (i == start[v] || scratch[i] != scratch[i - 1])
+					newNeighbors[write++] = scratch[i];
+		}
+	});
+	delete[] scratch;
+	delete[] start;
+
+	delete[] offsets;
+	delete[] neighbors;
+	delete[] weights;
+	offsets = unique;
+	neighbors = newNeighbors;
+	weights = NULL;
+	releasePending();
+}
+
+/******************************************************************
+ * LIST STORAGE
+ ******************************************************************/
+
+void ListStorage::init(int numNodes, int numCol) throw (const char*)
+{
+	Vector<int>* pNew;
+	try
+	{
+		pNew = new Vector<int>[numNodes];
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+	delete[] rows;
+	delete[] rowWeights;
+	rows = pNew;
+	rowWeights = NULL;
+	numV = numNodes;
+}
+
+ListStorage::ListStorage(const ListStorage & rhs) throw (const char*)
+	: numV(0), rows(NULL), rowWeights(NULL)
+{
+	*this = rhs;
+}
+
+ListStorage& ListStorage::operator=(const ListStorage & rhs) throw (const char*)
+{
+	if (&rhs == this)
+		return *this;
+	init(rhs.numV);
+	for (int v = 0; v < numV; ++v)
+		rows[v] = rhs.rows[v];
+	if (rhs.rowWeights)
+	{
+		try
+		{
+			rowWeights = new Vector<Weight>[numV];
+		}
+		catch (const std::bad_alloc)
+		{
+			throw "ERROR: Unable to allocate memory for the edge costs.";
+		}
+		for (int v = 0; v < numV; ++v)
+			rowWeights[v] = rhs.rowWeights[v];
+	}
+	return *this;
+}
+
+void ListStorage::clear()
+{
+	for (int v = 0; v < numV; ++v)
+		rows[v].clear();
+	delete[] rowWeights;
+	rowWeights = NULL;
+}
+
+/*********************************************
+ * LIST STORAGE :: ADD EDGE (weighted)
+ * The first edge that does not cost 1 gives every
+ * row a row of costs. Adding an edge that is
+ * already there replaces its cost.
+ ********************************************/
+void ListStorage::addEdge(int v1, int v2, Weight w) throw (const char*)
+{
+	if (!rowWeights && w != 1)
+	{
+		try
+		{
+			rowWeights = new Vector<Weight>[numV];
+		}
+		catch (const std::bad_alloc)
+		{
+			throw "ERROR: Unable to allocate memory for the edge costs.";
+		}
+		for (int v = 0; v < numV; ++v)
+			for (int i = 0; i < rows[v].size(); ++i)
+				rowWeights[v].push_back(1);
+	}
+
+	int i = find(v1, v2);
+	if (i == -1)
+	{
+		rows[v1].push_back(v2);
+		if (rowWeights)
+			rowWeights[v1].push_back(w);
+	}
+	else if (rowWeights)
+		rowWeights[v1][i] = w;
+}
+
+/******************************************************************
+ * GRID STORAGE
+ ******************************************************************/
+
+void GridStorage::init(int numNodes, int numCol) throw (const char*)
+{
+	// without a width, lay the cells out in one row
+	int width = numCol;
+	if (width <= 0)
+		width = numNodes > 0 ? numNodes : 1;
+	if (numNodes % width != 0)
+		throw "ERROR: The grid does not match the size of the maze.";
+	unsigned char* pNew;
+	try
+	{
+		pNew = new unsigned char[(numNodes + 1) / 2];
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+	delete[] cells;
+	cells = pNew;
+	numV = numNodes;
+	this->numCol = width;
+	clear();
+}
+
+GridStorage::GridStorage(const GridStorage & rhs) throw (const char*)
+	: numV(0), numCol(0), cells(NULL), weights(NULL)
+{
+	*this = rhs;
+}
+
+GridStorage& GridStorage::operator=(const GridStorage & rhs) throw (const char*)
+{
+	if (&rhs == this)
+		return *this;
+	unsigned char* pNew;
+	try
+	{
+		pNew = new unsigned char[(rhs.numV + 1) / 2];
+	}
+	catch (const std::bad_alloc)
+	{
+		throw "ERROR: Unable to allocate memory for the graph.";
+	}
+	delete[] cells;
+	cells = pNew;
+	numV = rhs.numV;
+	numCol = rhs.numCol;
+	for (int i = 0; i < (numV + 1) / 2; ++i)
+		cells[i] = rhs.cells[i];
+	delete[] weights;
+	weights = NULL;
+	if (rhs.weights)
+	{
+		weights = newWeights(2 * (size_t)numV);
+		for (size_t i = 0; i < 2 * (size_t)numV; ++i)
+			weights[i] = rhs.weights[i];
+	}
+	return *this;
+}
+
+void GridStorage::clear()
+{
+	for (int i = 0; i < (numV + 1) / 2; ++i)
+		cells[i] = 0;
+	delete[] weights;
+	weights = NULL;
+}
+
+/*********************************************
+ * GRID STORAGE :: ADD EDGE
+ * Open the wall between two neighboring cells,
+ * from both sides
+ ********************************************/
+void GridStorage::addEdge(int v1, int v2) throw (const char*)
+{
+	int d = direction(v1, v2);
+	if (d == 0)
+		throw "ERROR: A grid can only join neighboring cells.";
+	open(v1, d);
+	// the opposite wall is two bits over: NORTH <-> SOUTH, EAST <-> WEST
+	open(v2, d < SOUTH ? d << 2 : d >> 2);
+	if (weights)
+		weights[slot(v1, d)] = 1;
+}
+
+void GridStorage::addEdge(int v1, int v2, Weight w) throw (const char*)
+{
+	if (!weights && w != 1)
+		weights = newWeights(2 * (size_t)numV);
+	addEdge(v1, v2);
+	if (weights)
+		weights[slot(v1, direction(v1, v2))] = w;
+}
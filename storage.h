@@ -0,0 +1,399 @@
+/***********************************************************************
+ * Header:
+ *    STORAGE
+ * Summary:
+ *    The storage policies a Graph can be built on. Each one keeps the
+ *    edges between vertices numbered 0 .. numVertices() - 1 and offers
+ *    the same small set of methods:
+ *        init(numNodes, numCol) : room for numNodes vertices, numCol wide
+ *        numVertices()          : how many vertices there are
+ *        clear()                : remove every edge
+ *        hasEdge(v1, v2)        : is there an edge v1 --> v2?
+ *        addEdge(v1, v2)        : add the edge v1 --> v2
+ *        forEachEdge(v, f)      : call f(n) for every edge v --> n
+ *        pack()                 : finish deferred work before querying
+ *    Only GridStorage cares about numCol, the width of a maze grid.
+ *
+ *    The queries are const and, once the storage is packed, only read,
+ *    so any number of threads may make them at once. Only CsrStorage
+ *    defers work: its first query after an addEdge() packs, writing
+ *    the rows, so a CsrStorage must be packed before it is shared
+ *    between threads. The file readers and assign() pack on the way out.
+ *
+ *    Edges may also carry a small cost:
+ *        addEdge(v1, v2, w)     : add the edge v1 --> v2 costing w
+ *        weight(v1, v2)         : the cost of an existing edge
+ *        forEachWeightedEdge(v, f) : call f(n, w) for every edge v --> n
+ *        isWeighted()           : has any edge been given a cost?
+ *    An edge added without a cost costs 1. The costs are only stored
+ *    once some edge costs something else, so an unweighted graph pays
+ *    nothing for them; clear() drops them again.
+ *
+ *        DenseStorage : a bit matrix, one bit per possible edge
+ *        CsrStorage   : compressed sparse rows, offsets plus neighbors
+ *        ListStorage  : an adjacency list, one growable row per vertex
+ *        GridStorage  : a maze grid, four open-wall bits per cell
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <new>
+#include <vector>
+#include <algorithm>
+#include "bits.h"
+#include "vector.h"
+#include "vertex.h"
+#include "threadpool.h"
+
+typedef unsigned char Weight;   // the cost of one edge
+
+/*****************************************
+ * DENSE STORAGE
+ * An adjacency matrix with one bit per possible
+ * edge, each row padded out to a whole word.
+ * Best for dense graphs like the course graph.
+ ****************************************/
+class DenseStorage
+{
+public:
+	DenseStorage() : matrix(NULL), numV(0), rowWords(0) {}
+	DenseStorage(const DenseStorage& rhs) throw (const char*);
+	~DenseStorage() { delete[] matrix; }
+	DenseStorage& operator=(const DenseStorage& rhs) throw (const char*);
+
+	void init(int numNodes, int numCol = 0) throw (const char*);
+	int numVertices() const { return numV; }
+	void clear();
+	void pack() const {}
+
+	bool hasEdge(int v1, int v2) const
+	{
+		return (row(v1)[v2 / WORD_BITS] & bitMask(v2)) != 0;
+	}
+	void addEdge(int v1, int v2)
+	{
+		row(v1)[v2 / WORD_BITS] |= bitMask(v2);
+		if (!costs.empty())
+			setCost(v1, v2, 1);
+	}
+
+	// walk the row a word at a time, peeling off the lowest set bit
+	template <class Visit>
+	void forEachEdge(int v, Visit visit) const
+	{
+		const Word* r = row(v);
+		for (int w = 0; w < rowWords; ++w)
+			for (Word bits = r[w]; bits; bits &= bits - 1)
+				visit(w * WORD_BITS + countTrailingZeros(bits));
+	}
+
+	// only the edges that do not cost 1 keep their cost, in a sorted
+	// row of their own beside the bits, so a few weighted edges cost a
+	// few bytes rather than a byte for every possible edge
+	bool isWeighted() const { return !costs.empty(); }
+	void addEdge(int v1, int v2, Weight w) throw (const char*);
+	Weight weight(int v1, int v2) const
+	{
+		if (costs.empty())
+			return 1;
+		const CostRow& r = costs[v1];
+		CostRow::const_iterator it = std::lower_bound(r.begin(), r.end(),
+		                                              Cost(v2, 0));
+		return it != r.end() && it->first == v2 ? it->second : 1;
+	}
+	template <class Visit>
+	void forEachWeightedEdge(int v, Visit visit) const
+	{
+		if (costs.empty())
+		{
+			forEachEdge(v, [&](int n) { visit(n, (Weight)1); });
+			return;
+		}
+		// the bits come out in order, so one pass along the costs will do
+		CostRow::const_iterator it = costs[v].begin();
+		CostRow::const_iterator end = costs[v].end();
+		forEachEdge(v, [&](int n)
+		{
+			while (it != end && it->first < n)
+				++it;
+			visit(n, it != end && it->first == n ? it->second : (Weight)1);
+		});
+	}
+
+	// the raw bits of one row, numRowWords() words long
+	const Word* row(int v) const { return matrix + (size_t)v * rowWords; }
+	int numRowWords() const { return rowWords; }
+
+private:
+	typedef std::pair<int, Weight> Cost;   // (neighbor, cost)
+	typedef std::vector<Cost> CostRow;
+
+	Word* matrix;
+	std::vector<CostRow> costs;   // numV rows, or none when all cost 1
+	int numV;
+	int rowWords;
+
+	void setCost(int v1, int v2, Weight w);
+
+	Word* row(int v) { return matrix + (size_t)v * rowWords; }
+	size_t numMatrixWords() const { return (size_t)numV * rowWords; }
+};
+
+/*****************************************
+ * CSR STORAGE
+ * Compressed sparse rows: row v is
+ * neighbors[offsets[v] .. offsets[v + 1]), sorted.
+ * Memory is O(V + E). Edges given to addEdge() are
+ * buffered and packed into the rows in a single
+ * counting-sort pass the next time the graph is
+ * queried, or when pack() is called. That first
+ * query writes, so call pack() before handing the
+ * graph to more than one thread.
+ ****************************************/
+class CsrStorage
+{
+public:
+	CsrStorage() : numV(0), offsets(NULL), neighbors(NULL), weights(NULL) {}
+	CsrStorage(const CsrStorage& rhs) throw (const char*);
+	~CsrStorage() { delete[] offsets; delete[] neighbors; delete[] weights; }
+	CsrStorage& operator=(const CsrStorage& rhs) throw (const char*);
+
+	void init(int numNodes, int numCol = 0) throw (const char*);
+	int numVertices() const { return numV; }
+	int numEdges() const { pack(); return offsets[numV]; }
+	void clear();
+	void pack() const;
+
+	// replace every edge with the (from, to) pairs in the lists
+	void assign(const std::vector<int>* lists, int numLists, ThreadPool& pool)
+		throw (const char*);
+
+	bool hasEdge(int v1, int v2) const
+	{
+		pack();
+		return std::binary_search(neighbors + offsets[v1],
+		                          neighbors + offsets[v1 + 1], v2);
+	}
+	void addEdge(int v1, int v2)
+	{
+		pending.push_back(v1);
+		pending.push_back(v2);
+		if (weights)
+			pendingWeights.push_back(1);
+	}
+
+	template <class Visit>
+	void forEachEdge(int v, Visit visit) const
+	{
+		pack();
+		for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+			visit(neighbors[i]);
+	}
+
+	// the costs run parallel to neighbors; adding an edge again replaces its cost
+	bool isWeighted() const { return weights != NULL; }
+	void addEdge(int v1, int v2, Weight w) throw (const char*);
+	Weight weight(int v1, int v2) const
+	{
+		pack();
+		if (!weights)
+			return 1;
+		const int* found = std::lower_bound(neighbors + offsets[v1],
+		                                    neighbors + offsets[v1 + 1], v2);
+		return weights[found - neighbors];
+	}
+	template <class Visit>
+	void forEachWeightedEdge(int v, Visit visit) const
+	{
+		pack();
+		for (int i = offsets[v]; i < offsets[v + 1]; ++i)
+			visit(neighbors[i], weights ? weights[i] : (Weight)1);
+	}
+
+private:
+	int numV;
+	mutable int* offsets;        // numV + 1 entries
+	mutable int* neighbors;      // offsets[numV] entries
+	mutable Weight* weights;     // offsets[numV] costs, or NULL when all cost 1
+	mutable Vector<int> pending; // (from, to) pairs not yet packed
+	mutable Vector<Weight> pendingWeights; // their costs, when weighted
+
+	void packWeighted(int* newOffsets, int* newNeighbors, Weight* newWeights) const;
+	void releasePending() const;
+};
+
+/*****************************************
+ * LIST STORAGE
+ * An adjacency list: every vertex owns a growable
+ * row of its neighbors in the order they were added.
+ * Cheap to add to; queries scan one row.
+ ****************************************/
+class ListStorage
+{
+public:
+	ListStorage() : numV(0), rows(NULL), rowWeights(NULL) {}
+	ListStorage(const ListStorage& rhs) throw (const char*);
+	~ListStorage() { delete[] rows; delete[] rowWeights; }
+	ListStorage& operator=(const ListStorage& rhs) throw (const char*);
+
+	void init(int numNodes, int numCol = 0) throw (const char*);
+	int numVertices() const { return numV; }
+	void clear();
+	void pack() const {}
+
+	bool hasEdge(int v1, int v2) const { return find(v1, v2) != -1; }
+	void addEdge(int v1, int v2)
+	{
+		if (rowWeights)
+			addEdge(v1, v2, 1);
+		else if (!hasEdge(v1, v2))
+			rows[v1].push_back(v2);
+	}
+
+	template <class Visit>
+	void forEachEdge(int v, Visit visit) const
+	{
+		const Vector<int>& r = rows[v];
+		for (VectorConstIterator<int> it = r.cbegin(); it != r.cend(); ++it)
+			visit(*it);
+	}
+
+	// every row gets a matching row of costs
+	bool isWeighted() const { return rowWeights != NULL; }
+	void addEdge(int v1, int v2, Weight w) throw (const char*);
+	Weight weight(int v1, int v2) const
+	{
+		return rowWeights ? rowWeights[v1](find(v1, v2)) : 1;
+	}
+	template <class Visit>
+	void forEachWeightedEdge(int v, Visit visit) const
+	{
+		const Vector<int>& r = rows[v];
+		for (int i = 0; i < r.size(); ++i)
+			visit(r(i), rowWeights ? rowWeights[v](i) : (Weight)1);
+	}
+
+private:
+	int numV;
+	Vector<int>* rows;
+	Vector<Weight>* rowWeights;   // the cost of each edge in rows, or NULL
+
+	// where v2 is in the row of v1, -1 if it is not there
+	int find(int v1, int v2) const
+	{
+		const Vector<int>& r = rows[v1];
+		int i = 0;
+		for (VectorConstIterator<int> it = r.cbegin(); it != r.cend(); ++it, ++i)
+			if (*it == v2)
+				return i;
+		return -1;
+	}
+};
+
+/*****************************************
+ * GRID STORAGE
+ * A maze on a grid of CVertex cells where edges
+ * only ever join orthogonal neighbors. Each cell
+ * keeps a 4-bit mask of its open walls, two cells
+ * to a byte. Edges are undirected: opening the wall
+ * from one side opens it from the other. Memory is
+ * half a byte per cell.
+ ****************************************/
+class GridStorage
+{
+public:
+	// the open-wall bits of a cell
+	enum Direction { NORTH = 1, EAST = 2, SOUTH = 4, WEST = 8 };
+
+	GridStorage() : numV(0), numCol(0), cells(NULL), weights(NULL) {}
+	GridStorage(const GridStorage& rhs) throw (const char*);
+	~GridStorage() { delete[] cells; delete[] weights; }
+	GridStorage& operator=(const GridStorage& rhs) throw (const char*);
+
+	void init(int numNodes, int numCol = 0) throw (const char*);
+	int numVertices() const { return numV; }
+	int numColumns() const { return numCol; }
+	void clear();
+	void pack() const {}
+
+	// the open walls of a cell, and whether one wall is open
+	int walls(int v) const { return (cells[v >> 1] >> ((v & 1) * 4)) & 0xF; }
+	bool isOpen(int v, Direction d) const { return (walls(v) & d) != 0; }
+
+	bool hasEdge(int v1, int v2) const
+	{
+		int d = direction(v1, v2);
+		return d != 0 && (walls(v1) & d) != 0;
+	}
+	void addEdge(int v1, int v2) throw (const char*);
+
+	template <class Visit>
+	void forEachEdge(int v, Visit visit) const
+	{
+		int w = walls(v);
+		if (w & NORTH) visit(v - numCol);
+		if (w & WEST)  visit(v - 1);
+		if (w & EAST)  visit(v + 1);
+		if (w & SOUTH) visit(v + numCol);
+	}
+
+	// a cell keeps the cost of its east and south walls; both sides share it
+	bool isWeighted() const { return weights != NULL; }
+	void addEdge(int v1, int v2, Weight w) throw (const char*);
+	Weight weight(int v1, int v2) const
+	{
+		return weights ? weights[slot(v1, direction(v1, v2))] : 1;
+	}
+	template <class Visit>
+	void forEachWeightedEdge(int v, Visit visit) const
+	{
+		if (!weights)
+		{
+			forEachEdge(v, [&](int n) { visit(n, (Weight)1); });
+			return;
+		}
+		int w = walls(v);
+		if (w & NORTH) visit(v - numCol, weights[2 * (v - numCol) + 1]);
+		if (w & WEST)  visit(v - 1,      weights[2 * (v - 1)]);
+		if (w & EAST)  visit(v + 1,      weights[2 * v]);
+		if (w & SOUTH) visit(v + numCol, weights[2 * v + 1]);
+	}
+
+private:
+	int numV;
+	int numCol;
+	unsigned char* cells;
+	Weight* weights;   // east then south cost of every cell, or NULL
+
+	// where the cost of the wall of v facing d is kept
+	int slot(int v, int d) const
+	{
+		switch (d)
+		{
+		case EAST:  return 2 * v;
+		case SOUTH: return 2 * v + 1;
+		case WEST:  return 2 * (v - 1);
+		default:    return 2 * (v - numCol) + 1;
+		}
+	}
+
+	int direction(int v1, int v2) const
+	{
+		int d = v2 - v1;
+		if (d == numCol)
+			return SOUTH;
+		if (d == -numCol)
+			return NORTH;
+		if (d == 1 && v1 % numCol != numCol - 1)
+			return EAST;
+		if (d == -1 && v1 % numCol != 0)
+			return WEST;
+		return 0;
+	}
+	void open(int v, int d) { cells[v >> 1] |= (unsigned char)(d << ((v & 1) * 4)); }
+};
+
+#endif // STORAGE_H
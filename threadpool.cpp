@@ -0,0 +1,110 @@
+#include "threadpool.h"
+
+/*********************************************
+ * THREAD POOL : CONSTRUCTOR
+ * Start the workers. They sleep until run()
+ * hands them a batch.
+ ********************************************/
+ThreadPool::ThreadPool(int numThreads) :
+   job(NULL), numTasks(0), nextTask(0), numBusy(0), batch(0),
+   stopping(false), error(NULL)
+{
+   if (numThreads <= 0)
+      numThreads = (int)std::thread::hardware_concurrency();
+   if (numThreads <= 0)
+      numThreads = 1;
+   for (int thread = 1; thread < numThreads; thread++)
+      workers.push_back(std::thread(&ThreadPool::work, this, thread));
+}
+
+/*********************************************
+ * THREAD POOL : DESTRUCTOR
+ * Wake the workers so they can leave, then
+ * wait for them
+ ********************************************/
+ThreadPool::~ThreadPool()
+{
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+   }
+   wake.notify_all();
+   for (size_t i = 0; i < workers.size(); i++)
+      workers[i].join();
+}
+
+/*********************************************
+ * THREAD POOL :: RUN
+ * Hand out the batch and help with it. If a task
+ * throws, the rest of the batch still runs and the
+ * first error is thrown from here.
+ ********************************************/
+void ThreadPool::run(int numTasks,
+                     const std::function<void (int task, int thread)> & task)
+   throw (const char *)
+{
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      job = &task;
+      this->numTasks = numTasks;
+      nextTask = 0;
+      numBusy = (int)workers.size();
+      error = NULL;
+      batch++;
+   }
+   wake.notify_all();
+
+   claimTasks(0);
+
+   std::unique_lock<std::mutex> guard(lock);
+   finished.wait(guard, [this]() { return numBusy == 0; });
+   job = NULL;
+   if (error)
+      throw error;
+}
+
+/*********************************************
+ * THREAD POOL :: CLAIM TASKS
+ * Take tasks off the batch until it is empty
+ ********************************************/
+void ThreadPool::claimTasks(int thread)
+{
+   for (int i = nextTask++; i < numTasks; i = nextTask++)
+   {
+      try
+      {
+         (*job)(i, thread);
+      }
+      catch (const char * e)
+      {
+         std::lock_guard<std::mutex> guard(lock);
+         if (error == NULL)
+            error = e;
+      }
+   }
+}
+
+/*********************************************
+ * THREAD POOL :: WORK
+ * The body of each worker thread
+ ********************************************/
+void ThreadPool::work(int thread)
+{
+   unsigned int lastBatch = 0;
+   for (;;)
+   {
+      {
+         std::unique_lock<std::mutex> guard(lock);
+         wake.wait(guard, [&]() { return stopping || batch != lastBatch; });
+         if (stopping)
+            return;
+         lastBatch = batch;
+      }
+
+      claimTasks(thread);
+
+      std::lock_guard<std::mutex> guard(lock);
+      if (--numBusy == 0)
+         finished.notify_one();
+   }
+}
@@ -0,0 +1,69 @@
+/***********************************************************************
+ * Header:
+ *    THREAD POOL
+ * Summary:
+ *    A fixed set of worker threads that run batches of numbered tasks.
+ *    The calling thread joins in on every batch, so a pool of size 1
+ *    has no workers at all and simply runs the tasks in order.
+ * Author
+ *    Scott Tolman
+ ************************************************************************/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+// the items of a parallel loop given to one task, enough to outweigh
+// handing the task out; override with -DPARALLEL_GRAIN=...
+#ifndef PARALLEL_GRAIN
+#define PARALLEL_GRAIN 256
+#endif
+
+/*****************************************
+ * THREAD POOL
+ * run(numTasks, task) calls task(i, thread) for every
+ * i in [0, numTasks) and returns when they are all
+ * done. thread is in [0, size()) and is unique among
+ * the tasks running at the same moment, so it can
+ * index per-thread scratch space. One batch at a time.
+ ****************************************/
+class ThreadPool
+{
+public:
+   // numThreads of 0 means one per hardware thread
+   ThreadPool(int numThreads = 0);
+   ~ThreadPool();
+
+   int size() const { return (int)workers.size() + 1; }
+
+   void run(int numTasks, const std::function<void (int task, int thread)> & task)
+      throw (const char *);
+
+private:
+   ThreadPool(const ThreadPool & rhs);
+   ThreadPool & operator = (const ThreadPool & rhs);
+
+   void work(int thread);
+   void claimTasks(int thread);
+
+   std::vector<std::thread> workers;
+   std::mutex lock;
+   std::condition_variable wake;      // a new batch, or time to stop
+   std::condition_variable finished;  // the last worker is done
+
+   const std::function<void (int, int)> * job;
+   int numTasks;
+   std::atomic<int> nextTask;
+   int numBusy;
+   unsigned int batch;
+   bool stopping;
+   const char * error;                // the first error thrown by a task
+};
+
+#endif // THREADPOOL_H
@@ -108,6 +108,21 @@ class Vector
       // forget about all the elements
       void clear()                  { num = 0;         } 
 
+      // trade contents with rhs; swapping with an empty Vector frees
+      // the space that clear() keeps
+      void swap(Vector <T> & rhs)
+      {
+         T * tData = data;
+         int tMax  = max;
+         int tNum  = num;
+         data = rhs.data;
+         max  = rhs.max;
+         num  = rhs.num;
+         rhs.data = tData;
+         rhs.max  = tMax;
+         rhs.num  = tNum;
+      }
+
       // the various iterator methods
       VectorIterator <T> begin()  { return VectorIterator <T> (data);         }
       VectorIterator <T> end()    { return VectorIterator <T> (data + num);   }
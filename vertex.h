@@ -15,19 +15,39 @@
 #include <string>
 #include <cctype>
 #include <cassert>
+#include <climits>
 using std::string;
 
+/********************************************************
+ * VERTEX CONTEXT
+ * What a vertex index means: how many vertices there
+ * are and, on a grid, how many columns. Every graph
+ * owns one, so graphs of different shapes can live
+ * side by side and be used from different threads.
+ *******************************************************/
+struct VertexContext
+{
+   VertexContext(int max = 10, int maxCol = 0) : max(max), maxCol(maxCol) {}
+   int max;
+   int maxCol;
+};
+
 /********************************************************
  * VERTEX
- * A generic Vertex class serving as a base class
+ * A generic Vertex class serving as a base class. A vertex
+ * points at the context of the graph it came from, so it
+ * must not outlive that graph. Vertices made without a
+ * context share a process-wide default one.
  *******************************************************/
 class Vertex
 {
 public:
    // constructors (With validation)
-   Vertex() : i(0)          {             }
-   Vertex(int index) : i(0) { set(index); }
-   Vertex(const Vertex & v) { i = v.i;    }
+   Vertex() : i(0), context(&defaults())          {             }
+   Vertex(int index) : i(0), context(&defaults()) { set(index); }
+   Vertex(int index, const VertexContext & context) :
+      i(0), context(&context)                      { set(index); }
+   Vertex(const Vertex & v) : i(v.i), context(v.context) {      }
  
    // set (the validation part)
    bool set(int index) {
@@ -38,9 +58,15 @@ public:
 	   return false;
    }
 
-   // handle max
-   int getMax() const   { return max;                       }
-   void setMax(int max) { assert(max > 0); this->max = max; }            
+   // handle max. Setting it changes the default context.
+   int getMax() const   { return context->max;              }
+   void setMax(int max)
+   {
+      assert(max > 0);
+      defaults().max = max;
+      context = &defaults();
+   }
+   const VertexContext & getContext() const { return *context; }
    
    // I/O
    friend std::ostream & operator << (std::ostream & out, const Vertex & rhs);
@@ -60,11 +86,23 @@ public:
    bool operator == (const Vertex & rhs) const {return index() == rhs.index();}
    bool operator != (const Vertex & rhs) const {return index() != rhs.index();}
 
-   Vertex & operator = (const Vertex & rhs) { i = rhs.i; return *this; }
+   Vertex & operator = (const Vertex & rhs)
+   {
+      i = rhs.i;
+      context = rhs.context;
+      return *this;
+   }
    
 protected:
    int i;
-   static int max;
+   const VertexContext * context;
+
+   // the context of vertices that do not belong to a graph
+   static VertexContext & defaults()
+   {
+      static VertexContext context;
+      return context;
+   }
 };
 
 /**************************************************
@@ -150,9 +188,9 @@ public:
 class CourseVertex : public Vertex
 {
 public:
-   CourseVertex()        : Vertex() { max = NUM_CLASS;                }
-   CourseVertex(const Vertex & v)   { max = NUM_CLASS; i = v.index(); }
-   CourseVertex(int num) : Vertex() { set(num);                       }
+   CourseVertex()                 { context = &courses();                 }
+   CourseVertex(const Vertex & v) { context = &courses(); i = v.index();  }
+   CourseVertex(int num)          { context = &courses(); set(num);       }
    
    // return the text version of the index: 0 --> CS124
    string getText() const          { return nameFromIndex(i);        }
@@ -168,9 +206,25 @@ public:
          }
       return false;
    }
+
+   // the index of a class name that is not null-terminated, -1 if none
+   static int indexFromText(const char * s, int length)
+   {
+      for (int i = 0; i < NUM_CLASS; i++)
+         if (nameFromIndex(i).compare(0, string::npos, s, length) == 0)
+            return i;
+      return -1;
+   }
 private:
+   // there are always NUM_CLASS classes
+   static const VertexContext & courses()
+   {
+      static const VertexContext context(NUM_CLASS);
+      return context;
+   }
+
    // because this is a bit non-trivial, we need a separate function for this
-   string & nameFromIndex(int i) const
+   static string & nameFromIndex(int i)
    {
       // all the classes in the sequence
       static string classes[] =
@@ -200,6 +254,75 @@ private:
    }
 };
 
+/***********************************************
+ * CELL TEXT
+ * Grid cells are named spreadsheet style: the
+ * column is a run of letters (a .. z, aa .. az,
+ * ba ...) and the row a 1-based number, so b4 is
+ * column 1, row 3 and aa100 is column 26, row 99.
+ * Neither direction allocates, so the maze reader
+ * and the vertex share them.
+ ***********************************************/
+#define CELL_TEXT_MAX 24   // room for any cell with int coordinates
+
+// "aa100" --> (26, 99). False if it is not a cell name.
+inline bool parseCell(const char * s, int length, int & col, int & row)
+{
+   // the column: letters in bijective base 26
+   int n = 0;
+   int pos = 0;
+   for (; pos < length && s[pos] >= 'a' && s[pos] <= 'z'; pos++)
+   {
+      int letter = s[pos] - 'a' + 1;
+      if (n > (INT_MAX - letter) / 26)
+         return false;
+      n = n * 26 + letter;
+   }
+   if (pos == 0 || pos == length)
+      return false;
+
+   // the row: a plain 1-based number
+   int r = 0;
+   for (; pos < length; pos++)
+   {
+      int digit = s[pos] - '0';
+      if (digit < 0 || digit > 9 || r > (INT_MAX - digit) / 10)
+         return false;
+      r = r * 10 + digit;
+   }
+   if (r == 0)
+      return false;
+
+   col = n - 1;
+   row = r - 1;
+   return true;
+}
+
+// (26, 99) --> "aa100". The buffer holds CELL_TEXT_MAX
+// characters; returns the length, not counting the null.
+inline int formatCell(int col, int row, char * buffer)
+{
+   assert(col >= 0 && row >= 0);
+   char digits[CELL_TEXT_MAX];
+   int numDigits = 0;
+
+   // the column, least significant letter first
+   for (unsigned int n = (unsigned int)col + 1; n > 0; n = (n - 1) / 26)
+      digits[numDigits++] = (char)('a' + (n - 1) % 26);
+   int length = 0;
+   while (numDigits > 0)
+      buffer[length++] = digits[--numDigits];
+
+   // the row, least significant digit first
+   for (unsigned int n = (unsigned int)row + 1; n > 0; n /= 10)
+      digits[numDigits++] = (char)('0' + n % 10);
+   while (numDigits > 0)
+      buffer[length++] = digits[--numDigits];
+
+   buffer[length] = '\0';
+   return length;
+}
+
 /***********************************************
  * COORDIANTES VERTEX
  * Verticies that are identified by coordinates on a grid
@@ -207,10 +330,13 @@ private:
 class CVertex : public Vertex
 {
 public:
-   CVertex()                    : Vertex() {                }
-   CVertex(int col, int row)    : Vertex() { set(col, row); }
-   CVertex(const CVertex & rhs) : Vertex() { i = rhs.i;     }
-   CVertex(const  Vertex & rhs) : Vertex() { i = rhs.index();     }
+   CVertex()                    : Vertex()    {                }
+   CVertex(int col, int row)    : Vertex()    { set(col, row); }
+   CVertex(const CVertex & rhs) : Vertex(rhs) {                }
+   CVertex(const  Vertex & rhs) : Vertex(rhs) {                }
+   CVertex(const VertexContext & context) : Vertex(0, context) {}
+   CVertex(int col, int row, const VertexContext & context) :
+      Vertex(0, context)                      { set(col, row); }
 
    // set a given vertex
    bool set(int col, int row)
@@ -229,49 +355,44 @@ public:
    // return the text version of the index: (1,3) --> b4
    string getText() const
    {
-      string s;
-      // column is letter a .. z (or whatever)
-      // row is number 1 ... 100 (or whatever)
-      s += (char)(getCol() + 'a');
-      if (getRow() < 9)
-         s += (char)(getRow() + '1');
-      else
-      {
-         assert((getRow() + 1) / 10 >= 0 && (getRow() + 1) / 10 <= 9);
-         assert((getRow() + 1) % 10 >= 0 && (getRow() + 1) % 10 <= 9);         
-         s += (char)((getRow() + 1) / 10 + '0');
-         s += (char)((getRow() + 1) % 10 + '0');
-      }
-      return s;
+      char buffer[CELL_TEXT_MAX];
+      int length = formatText(buffer);
+      return string(buffer, length);
+   }
+
+   // the same, into a buffer of CELL_TEXT_MAX characters
+   int formatText(char * buffer) const
+   {
+      return formatCell(getCol(), getRow(), buffer);
    }
    
    // set an index based on the text: b4 --> (1,3)
    bool setText(const string & s)
    {
-      if (s.size() == 2)
-         return set(s[0] - 'a', s[1] - '1');
-	  else if (s.size() == 0)//line for Visual Studio
-		  return false;
-      else
-         return set(s[0] - 'a', (s[1] - '0') * 10 + (s[2] - '0') - 1);
+      return setText(s.data(), (int)s.size());
+   }
+
+   bool setText(const char * s, int length)
+   {
+      int col;
+      int row;
+      return parseCell(s, length, col, row) && set(col, row);
    }
 
    // get the column and row from the current index
    int getRow()    const { return i / getMaxCol();        }
    int getCol()    const { return i % getMaxCol();        }
-   int getMaxCol() const { return maxCol;                 }
+   int getMaxCol() const { return context->maxCol;        }
    int getMaxRow() const { return getMax() / getMaxCol(); }
 
-   // set the max row
+   // set the max row. This changes the default context.
    void setMax(int col, int row)
    {
-      assert(col > 0 && row > 0 && col < 26 && row < 100);
-      maxCol = col;
-      max    = col * row;
+      assert(col > 0 && row > 0 && col <= INT_MAX / row);
+      defaults().maxCol = col;
+      defaults().max    = col * row;
+      context = &defaults();
    }
-
-private:
-   static int maxCol;
 };
 
 